@@ -3,4 +3,6 @@
 #include "DungeonEscapeVR.h"
 #include "Modules/ModuleManager.h"
 
+DEFINE_LOG_CATEGORY(LogDungeonEscapeVR);
+
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, DungeonEscapeVR, "DungeonEscapeVR" );
@@ -3,5 +3,13 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Stats/Stats.h"
 
-#define ECC_VRController ECollisionChannel::ECC_GameTraceChannel1
\ No newline at end of file
+#define ECC_VRController ECollisionChannel::ECC_GameTraceChannel1
+
+/** Game stats, view in game with "stat DungeonEscapeVR" */
+DECLARE_STATS_GROUP(TEXT("DungeonEscapeVR"), STATGROUP_DungeonEscapeVR, STATCAT_Advanced);
+
+
+/** Game log category */
+DECLARE_LOG_CATEGORY_EXTERN(LogDungeonEscapeVR, Log, All);
\ No newline at end of file
@@ -0,0 +1,161 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Collision/DBuildDistanceFieldCommandlet.h"
+
+// Engine Includes
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+
+// Game Includes
+#include "../DungeonEscapeVR.h"
+#include "Collision/DStaticDistanceField.h"
+
+
+UDBuildDistanceFieldCommandlet::UDBuildDistanceFieldCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+
+int32 UDBuildDistanceFieldCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	FString MapPrefix = TEXT("Dungeon_Escape_L1");
+	float VoxelSize = 10.f;
+	float MaxDistance = 60.f;
+	int32 NumValidationSamples = 10000;
+	FParse::Value(*Params, TEXT("Maps="), MapPrefix);
+	FParse::Value(*Params, TEXT("VoxelSize="), VoxelSize);
+	FParse::Value(*Params, TEXT("MaxDistance="), MaxDistance);
+	FParse::Value(*Params, TEXT("ValidationSamples="), NumValidationSamples);
+	const bool bValidate = FParse::Param(*Params, TEXT("Validate"));
+
+	TArray<FString> MapFilenames;
+	const FString MapsDirectory = FPaths::ProjectContentDir() / TEXT("DungeonEscapeVR/Maps");
+	IFileManager::Get().FindFiles(MapFilenames, *(MapsDirectory / MapPrefix + TEXT("*") + FPackageName::GetMapPackageExtension()), true, false);
+	if (MapFilenames.Num() == 0)
+	{
+		UE_LOG(LogDungeonEscapeVR, Error, TEXT("No maps found in %s starting with %s"), *MapsDirectory, *MapPrefix);
+		return 1;
+	}
+
+	int32 NumFailed = 0;
+	for (const FString& MapFilename : MapFilenames)
+	{
+		const FString MapName = FPaths::GetBaseFilename(MapFilename);
+		UPackage* Package = LoadPackage(nullptr, *(FString(TEXT("/Game/DungeonEscapeVR/Maps/")) + MapName), LOAD_None);
+		UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+		if (!World)
+		{
+			UE_LOG(LogDungeonEscapeVR, Error, TEXT("Failed to load map %s"), *MapName);
+			++NumFailed;
+			continue;
+		}
+
+		// Register components so static collision is added to the physics scene
+		World->WorldType = EWorldType::Editor;
+		World->AddToRoot();
+		if (!World->bIsWorldInitialized)
+		{
+			World->InitWorld(UWorld::InitializationValues()
+				.CreatePhysicsScene(true)
+				.CreateNavigation(false)
+				.CreateAISystem(false)
+				.AllowAudioPlayback(false)
+				.RequiresHitProxies(false)
+				.ShouldSimulatePhysics(false)
+				.SetTransactional(false));
+		}
+		World->UpdateWorldComponents(true, false);
+
+		TArray<uint8> Data;
+		const FString Filename = FDStaticDistanceField::GetFilename(MapName);
+		if (FDStaticDistanceField::Build(World, VoxelSize, MaxDistance, Data) && FFileHelper::SaveArrayToFile(Data, *Filename))
+		{
+			UE_LOG(LogDungeonEscapeVR, Display, TEXT("Built static distance field %s, %d KB"), *Filename, Data.Num() / 1024);
+
+			if (bValidate)
+			{
+				FDStaticDistanceField DistanceField;
+				if (!DistanceField.Load(Filename) || !ValidateDistanceField(World, DistanceField, NumValidationSamples))
+				{
+					++NumFailed;
+				}
+			}
+		}
+		else
+		{
+			UE_LOG(LogDungeonEscapeVR, Error, TEXT("Failed to build static distance field for map %s"), *MapName);
+			++NumFailed;
+		}
+
+		World->RemoveFromRoot();
+		World->CleanupWorld();
+		CollectGarbage(RF_NoFlags);
+	}
+
+	return NumFailed > 0 ? 1 : 0;
+#else
+	return 1;
+#endif
+}
+
+
+#if WITH_EDITOR
+
+bool UDBuildDistanceFieldCommandlet::ValidateDistanceField(UWorld* World, const FDStaticDistanceField& DistanceField, int32 NumSamples) const
+{
+	// Distance field only contains static collision, ignore everything that can move
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ValidateDistanceField), false);
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		TInlineComponentArray<UPrimitiveComponent*> PrimitiveComponents(*It);
+		for (UPrimitiveComponent* PrimitiveComponent : PrimitiveComponents)
+		{
+			if (PrimitiveComponent->Mobility != EComponentMobility::Static)
+			{
+				QueryParams.AddIgnoredComponent(PrimitiveComponent);
+			}
+		}
+	}
+
+	// Trilinear filtering is off by at most a voxel diagonal, quantization by half a step
+	const float Tolerance = DistanceField.GetVoxelSize() * FMath::Sqrt(3.f) + DistanceField.GetMaxDistance() / 255.f;
+	const FBox Bounds = DistanceField.GetBounds();
+
+	// Fixed seed so results can be compared between runs
+	FRandomStream RandomStream(0);
+	int32 NumErrors = 0;
+
+	for (int32 i = 0; i < NumSamples; ++i)
+	{
+		const FVector Location(RandomStream.FRandRange(Bounds.Min.X, Bounds.Max.X), RandomStream.FRandRange(Bounds.Min.Y, Bounds.Max.Y), RandomStream.FRandRange(Bounds.Min.Z, Bounds.Max.Z));
+		const float Distance = DistanceField.GetDistance(Location);
+
+		// A sphere smaller than the distance must not touch static collision, a sphere larger than the distance must unless the distance was clamped
+		const float InnerRadius = Distance - Tolerance;
+		const float OuterRadius = Distance + Tolerance;
+		const bool bInnerSphereClear = InnerRadius <= 0.f || !World->OverlapBlockingTestByChannel(Location, FQuat::Identity, ECollisionChannel::ECC_Visibility, FCollisionShape::MakeSphere(InnerRadius), QueryParams);
+		const bool bOuterSphereBlocked = OuterRadius >= DistanceField.GetMaxDistance() || World->OverlapBlockingTestByChannel(Location, FQuat::Identity, ECollisionChannel::ECC_Visibility, FCollisionShape::MakeSphere(OuterRadius), QueryParams);
+
+		if (!bInnerSphereClear || !bOuterSphereBlocked)
+		{
+			UE_LOG(LogDungeonEscapeVR, Verbose, TEXT("Distance field sample at %s is %.1f, inner sphere clear %d, outer sphere blocked %d"), *Location.ToString(), Distance, bInnerSphereClear, bOuterSphereBlocked);
+			++NumErrors;
+		}
+	}
+
+	UE_LOG(LogDungeonEscapeVR, Display, TEXT("Validated static distance field, %d of %d samples outside %.1f cm tolerance"), NumErrors, NumSamples, Tolerance);
+	return NumErrors == 0;
+}
+
+#endif
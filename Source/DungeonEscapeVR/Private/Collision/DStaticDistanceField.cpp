@@ -0,0 +1,276 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Collision/DStaticDistanceField.h"
+
+// Engine Includes
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/Paths.h"
+
+#if WITH_EDITOR
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#endif
+
+
+FDStaticDistanceField::FDStaticDistanceField()
+	: Header(nullptr)
+	, BrickIndices(nullptr)
+	, BrickSamples(nullptr)
+{
+}
+
+
+FDStaticDistanceField::~FDStaticDistanceField()
+{
+	Unload();
+}
+
+
+bool FDStaticDistanceField::Load(const FString& Filename)
+{
+	Unload();
+
+	MappedFileHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Filename));
+	if (!MappedFileHandle || MappedFileHandle->GetFileSize() < static_cast<int64>(sizeof(FDStaticDistanceFieldHeader)))
+	{
+		Unload();
+		return false;
+	}
+
+	const int64 FileSize = MappedFileHandle->GetFileSize();
+	MappedFileRegion.Reset(MappedFileHandle->MapRegion(0, FileSize));
+	if (!MappedFileRegion)
+	{
+		Unload();
+		return false;
+	}
+
+	const uint8* Data = MappedFileRegion->GetMappedPtr();
+	const FDStaticDistanceFieldHeader* MappedHeader = reinterpret_cast<const FDStaticDistanceFieldHeader*>(Data);
+	const int64 NumBrickCells = static_cast<int64>(MappedHeader->BrickCount.X) * MappedHeader->BrickCount.Y * MappedHeader->BrickCount.Z;
+	const int64 ExpectedFileSize = sizeof(FDStaticDistanceFieldHeader) + NumBrickCells * sizeof(int32) + static_cast<int64>(MappedHeader->NumBricks) * BRICK_SAMPLE_COUNT;
+
+	// Baked with a different version or truncated, rebuild with UDBuildDistanceFieldCommandlet
+	if (MappedHeader->Magic != FILE_MAGIC || MappedHeader->Version != FILE_VERSION || MappedHeader->VoxelSize <= 0.f || FileSize != ExpectedFileSize)
+	{
+		Unload();
+		return false;
+	}
+
+	Header = MappedHeader;
+	BrickIndices = reinterpret_cast<const int32*>(Data + sizeof(FDStaticDistanceFieldHeader));
+	BrickSamples = reinterpret_cast<const uint8*>(BrickIndices + NumBrickCells);
+	return true;
+}
+
+
+void FDStaticDistanceField::Unload()
+{
+	Header = nullptr;
+	BrickIndices = nullptr;
+	BrickSamples = nullptr;
+
+	// Region must be unmapped before its file handle is closed
+	MappedFileRegion.Reset();
+	MappedFileHandle.Reset();
+}
+
+
+float FDStaticDistanceField::GetDistance(const FVector& Location) const
+{
+	if (!Header) return MAX_FLT;
+
+	// Location in samples from Origin
+	const FVector SampleLocation = (Location - Header->Origin) / Header->VoxelSize;
+	const int32 BrickX = FMath::FloorToInt(SampleLocation.X / BRICK_CELLS);
+	const int32 BrickY = FMath::FloorToInt(SampleLocation.Y / BRICK_CELLS);
+	const int32 BrickZ = FMath::FloorToInt(SampleLocation.Z / BRICK_CELLS);
+
+	if (BrickX < 0 || BrickY < 0 || BrickZ < 0 || BrickX >= Header->BrickCount.X || BrickY >= Header->BrickCount.Y || BrickZ >= Header->BrickCount.Z)
+	{
+		return Header->MaxDistance;
+	}
+
+	// Brick not stored, no static collision within MaxDistance
+	const int32 BrickIndex = BrickIndices[(BrickZ * Header->BrickCount.Y + BrickY) * Header->BrickCount.X + BrickX];
+	if (BrickIndex == INDEX_NONE) return Header->MaxDistance;
+
+	// Trilinear filter the 8 samples around Location
+	const FVector BrickLocation = SampleLocation - FVector(BrickX, BrickY, BrickZ) * BRICK_CELLS;
+	const int32 X = FMath::Clamp(FMath::FloorToInt(BrickLocation.X), 0, BRICK_CELLS - 1);
+	const int32 Y = FMath::Clamp(FMath::FloorToInt(BrickLocation.Y), 0, BRICK_CELLS - 1);
+	const int32 Z = FMath::Clamp(FMath::FloorToInt(BrickLocation.Z), 0, BRICK_CELLS - 1);
+	const FVector Alpha = BrickLocation - FVector(X, Y, Z);
+
+	const uint8* Samples = BrickSamples + static_cast<int64>(BrickIndex) * BRICK_SAMPLE_COUNT;
+	auto GetSample = [Samples](int32 SX, int32 SY, int32 SZ) -> float
+	{
+		return Samples[(SZ * BRICK_SAMPLES + SY) * BRICK_SAMPLES + SX];
+	};
+
+	const float Y0Z0 = FMath::Lerp(GetSample(X, Y, Z), GetSample(X + 1, Y, Z), Alpha.X);
+	const float Y1Z0 = FMath::Lerp(GetSample(X, Y + 1, Z), GetSample(X + 1, Y + 1, Z), Alpha.X);
+	const float Y0Z1 = FMath::Lerp(GetSample(X, Y, Z + 1), GetSample(X + 1, Y, Z + 1), Alpha.X);
+	const float Y1Z1 = FMath::Lerp(GetSample(X, Y + 1, Z + 1), GetSample(X + 1, Y + 1, Z + 1), Alpha.X);
+	const float Sample = FMath::Lerp(FMath::Lerp(Y0Z0, Y1Z0, Alpha.Y), FMath::Lerp(Y0Z1, Y1Z1, Alpha.Y), Alpha.Z);
+
+	return Sample / 255.f * Header->MaxDistance;
+}
+
+
+FBox FDStaticDistanceField::GetBounds() const
+{
+	if (!Header) return FBox(ForceInit);
+
+	const FVector BrickCount(Header->BrickCount.X, Header->BrickCount.Y, Header->BrickCount.Z);
+	return FBox(Header->Origin, Header->Origin + BrickCount * Header->VoxelSize * BRICK_CELLS);
+}
+
+
+FString FDStaticDistanceField::GetFilename(const FString& MapName)
+{
+	// Staged as non UFS so the file can be memory mapped, see DirectoriesToAlwaysStageAsNonUFS in DefaultGame.ini
+	return FPaths::ProjectContentDir() / TEXT("DungeonEscapeVR/DistanceFields") / MapName + TEXT(".sdf");
+}
+
+
+#if WITH_EDITOR
+
+namespace
+{
+	/** Distance from Location to Component's collision, clamped to MaxDistance */
+	float GetDistanceToComponentCollision(UPrimitiveComponent* Component, const FVector& Location, float MaxDistance)
+	{
+		FVector ClosestPoint;
+		const float Distance = Component->GetDistanceToCollision(Location, ClosestPoint);
+		if (Distance >= 0.f) return FMath::Min(Distance, MaxDistance);
+
+		// Point distance is not supported by all collision, e.g. triangle meshes. Find the largest sphere not overlapping the component instead
+		if (!Component->OverlapComponent(Location, FQuat::Identity, FCollisionShape::MakeSphere(MaxDistance))) return MaxDistance;
+
+		float MinRadius = 0.f;
+		float MaxRadius = MaxDistance;
+		for (int32 i = 0; i < 8; ++i)
+		{
+			const float Radius = (MinRadius + MaxRadius) * 0.5f;
+			if (Component->OverlapComponent(Location, FQuat::Identity, FCollisionShape::MakeSphere(Radius)))
+			{
+				MaxRadius = Radius;
+			}
+			else
+			{
+				MinRadius = Radius;
+			}
+		}
+
+		return MinRadius;
+	}
+}
+
+
+bool FDStaticDistanceField::Build(UWorld* World, float VoxelSize, float MaxDistance, TArray<uint8>& OutData)
+{
+	if (!World || VoxelSize <= 0.f || MaxDistance <= 0.f) return false;
+
+	// Static collision camera collision sweeps are blocked by
+	TArray<UPrimitiveComponent*> StaticComponents;
+	FBox StaticBounds(ForceInit);
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		TInlineComponentArray<UPrimitiveComponent*> PrimitiveComponents(*It);
+		for (UPrimitiveComponent* PrimitiveComponent : PrimitiveComponents)
+		{
+			if (PrimitiveComponent->IsRegistered() && PrimitiveComponent->Mobility == EComponentMobility::Static && PrimitiveComponent->IsQueryCollisionEnabled() &&
+				PrimitiveComponent->GetCollisionResponseToChannel(ECollisionChannel::ECC_Visibility) == ECollisionResponse::ECR_Block)
+			{
+				StaticComponents.Add(PrimitiveComponent);
+				StaticBounds += PrimitiveComponent->Bounds.GetBox();
+			}
+		}
+	}
+
+	if (StaticComponents.Num() == 0) return false;
+
+	const float BrickSize = VoxelSize * BRICK_CELLS;
+	const FVector FieldSize = StaticBounds.GetSize() + FVector(2.f * MaxDistance);
+
+	FDStaticDistanceFieldHeader NewHeader;
+	NewHeader.Magic = FILE_MAGIC;
+	NewHeader.Version = FILE_VERSION;
+	NewHeader.Origin = StaticBounds.Min - FVector(MaxDistance);
+	NewHeader.VoxelSize = VoxelSize;
+	NewHeader.MaxDistance = MaxDistance;
+	NewHeader.BrickCount = FIntVector(FMath::CeilToInt(FieldSize.X / BrickSize), FMath::CeilToInt(FieldSize.Y / BrickSize), FMath::CeilToInt(FieldSize.Z / BrickSize));
+	NewHeader.NumBricks = 0;
+
+	TArray<int32> NewBrickIndices;
+	NewBrickIndices.Init(INDEX_NONE, NewHeader.BrickCount.X * NewHeader.BrickCount.Y * NewHeader.BrickCount.Z);
+
+	TArray<uint8> NewBrickSamples;
+	TArray<UPrimitiveComponent*> BrickComponents;
+	uint8 Samples[BRICK_SAMPLE_COUNT];
+
+	for (int32 BrickZ = 0; BrickZ < NewHeader.BrickCount.Z; ++BrickZ)
+	{
+		for (int32 BrickY = 0; BrickY < NewHeader.BrickCount.Y; ++BrickY)
+		{
+			for (int32 BrickX = 0; BrickX < NewHeader.BrickCount.X; ++BrickX)
+			{
+				const FVector BrickMin = NewHeader.Origin + FVector(BrickX, BrickY, BrickZ) * BrickSize;
+				const FBox BrickBounds = FBox(BrickMin, BrickMin + FVector(BrickSize)).ExpandBy(MaxDistance);
+
+				BrickComponents.Reset();
+				for (UPrimitiveComponent* StaticComponent : StaticComponents)
+				{
+					if (StaticComponent->Bounds.GetBox().Intersect(BrickBounds))
+					{
+						BrickComponents.Add(StaticComponent);
+					}
+				}
+
+				if (BrickComponents.Num() == 0) continue;
+
+				bool bBrickNearCollision = false;
+				for (int32 SZ = 0; SZ < BRICK_SAMPLES; ++SZ)
+				{
+					for (int32 SY = 0; SY < BRICK_SAMPLES; ++SY)
+					{
+						for (int32 SX = 0; SX < BRICK_SAMPLES; ++SX)
+						{
+							const FVector SampleLocation = BrickMin + FVector(SX, SY, SZ) * VoxelSize;
+
+							float Distance = MaxDistance;
+							for (UPrimitiveComponent* BrickComponent : BrickComponents)
+							{
+								Distance = FMath::Min(Distance, GetDistanceToComponentCollision(BrickComponent, SampleLocation, Distance));
+								if (Distance <= 0.f) break;
+							}
+
+							const uint8 Sample = static_cast<uint8>(FMath::RoundToInt(Distance / MaxDistance * 255.f));
+							Samples[(SZ * BRICK_SAMPLES + SY) * BRICK_SAMPLES + SX] = Sample;
+							bBrickNearCollision |= Sample < 255;
+						}
+					}
+				}
+
+				// Every sample at MaxDistance, same as not storing the brick
+				if (!bBrickNearCollision) continue;
+
+				NewBrickIndices[(BrickZ * NewHeader.BrickCount.Y + BrickY) * NewHeader.BrickCount.X + BrickX] = NewHeader.NumBricks++;
+				NewBrickSamples.Append(Samples, BRICK_SAMPLE_COUNT);
+			}
+		}
+	}
+
+	const int32 BrickIndicesSize = NewBrickIndices.Num() * static_cast<int32>(sizeof(int32));
+	OutData.Reset(static_cast<int32>(sizeof(FDStaticDistanceFieldHeader)) + BrickIndicesSize + NewBrickSamples.Num());
+	OutData.Append(reinterpret_cast<const uint8*>(&NewHeader), static_cast<int32>(sizeof(FDStaticDistanceFieldHeader)));
+	OutData.Append(reinterpret_cast<const uint8*>(NewBrickIndices.GetData()), BrickIndicesSize);
+	OutData.Append(NewBrickSamples);
+	return true;
+}
+
+#endif
@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Collision/DStaticDistanceFieldSubsystem.h"
+
+// Engine Includes
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+
+// Game Includes
+#include "../DungeonEscapeVR.h"
+
+
+void UDStaticDistanceFieldSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	UWorld* World = GetWorld();
+	if (!World || !World->IsGameWorld()) return;
+
+	// Map name without PIE prefix, e.g. Dungeon_Escape_L1_2
+	const FString MapName = UWorld::RemovePIEPrefix(FPackageName::GetShortName(World->GetOutermost()));
+	const FString Filename = FDStaticDistanceField::GetFilename(MapName);
+
+	if (DistanceField.Load(Filename))
+	{
+		UE_LOG(LogDungeonEscapeVR, Log, TEXT("Loaded static distance field %s"), *Filename);
+	}
+}
+
+
+void UDStaticDistanceFieldSubsystem::Deinitialize()
+{
+	DistanceField.Unload();
+
+	Super::Deinitialize();
+}
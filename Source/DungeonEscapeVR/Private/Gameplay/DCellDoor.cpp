@@ -6,11 +6,13 @@
 // Engine Includes
 #include "Components/BoxComponent.h"
 #include "Components/StaticMeshComponent.h"
+#include "Curves/CurveFloat.h"
 #include "Kismet/GameplayStatics.h"
 
 
 // Game Includes
 #include "DGameModeBase.h"
+#include "Gameplay/DCellDoorMotionSubsystem.h"
 #include "Gameplay/DCellDoorTrigger.h"
 
 
@@ -22,6 +24,8 @@ ADCellDoor::ADCellDoor()
 
 	CellDoorStaticMeshComp = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("CellDoorStaticMesh"));
 	CellDoorStaticMeshComp->SetupAttachment(GetRootComponent());
+	// Visual only, CellDoorBlockingCollision blocks. Moving the cell door skips overlap updates
+	CellDoorStaticMeshComp->SetGenerateOverlapEvents(false);
 
 	CellDoorBlockingCollision = CreateDefaultSubobject<UBoxComponent>(TEXT("BlockingBoxComp"));
 	CellDoorBlockingCollision->SetupAttachment(GetRootComponent());
@@ -31,10 +35,16 @@ ADCellDoor::ADCellDoor()
 
 	CellDoorState = ECellDoorState::ECDS_Closed;
 
+	OpenCellDoorCurve = nullptr;
+	CloseCellDoorCurve = nullptr;
+	ActiveMotionCurve = nullptr;
+	MotionTime = 0.f;
+
 	bDebugForceGateOpen = false;
 	bGameModeForceAllGatesOpen = false;
 
-	PrimaryActorTick.bCanEverTick = true;
+	// Door state is driven by trigger weight change notifications, movement by UDCellDoorMotionSubsystem or the timeline in derived blueprint
+	PrimaryActorTick.bCanEverTick = false;
 }
 
 
@@ -56,14 +66,46 @@ void ADCellDoor::BeginPlay()
 	}
 
 #endif
+
+	for (ADCellDoorTrigger* Trigger : CellDoorTriggers)
+	{
+		if (Trigger)
+		{
+			Trigger->OnWeightChanged.AddUObject(this, &ADCellDoor::OnTriggerWeightChanged);
+		}
+	}
+
+	// Keys may already be placed, or debug forces door open
+	ProcessDoorOpenCloseState();
+}
+
+
+void ADCellDoor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UDCellDoorMotionSubsystem* MotionSubsystem = GetWorld()->GetSubsystem<UDCellDoorMotionSubsystem>())
+	{
+		MotionSubsystem->RemoveMovingCellDoor(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 
-// Called every frame
-void ADCellDoor::Tick(float DeltaTime)
+#if WITH_EDITOR
+void ADCellDoor::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
-	Super::Tick(DeltaTime);
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	if (HasActorBegunPlay() && PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(ADCellDoor, bDebugForceGateOpen))
+	{
+		ProcessDoorOpenCloseState();
+	}
+}
+#endif
 
+
+void ADCellDoor::OnTriggerWeightChanged(ADCellDoorTrigger* CellDoorTrigger)
+{
 	ProcessDoorOpenCloseState();
 }
 
@@ -108,7 +150,10 @@ float ADCellDoor::CalculateTotalWeightOnTriggers() const
 	float WeightOnTriggers = 0.f;
 	for (const auto& Trigger : CellDoorTriggers)
 	{
-		WeightOnTriggers += Trigger->GetWeightOnTrigger();
+		if (Trigger)
+		{
+			WeightOnTriggers += Trigger->GetWeightOnTrigger();
+		}
 	}
 
 	return WeightOnTriggers;
@@ -123,7 +168,10 @@ void ADCellDoor::OpenCellDoor()
 	CellDoorState = ECellDoorState::ECDS_Opening;
 	OnCellDoorStateChange.Broadcast(this, CellDoorState);
 
-	BP_OpenCellDoor();
+	if (!StartCellDoorMotion(OpenCellDoorCurve))
+	{
+		BP_OpenCellDoor();
+	}
 }
 
 
@@ -142,11 +190,67 @@ void ADCellDoor::CloseCellDoor()
 		CellDoorBlockingCollision->SetCanEverAffectNavigation(true);
 	}
 
-	BP_CloseCellDoor();
+	if (!StartCellDoorMotion(CloseCellDoorCurve))
+	{
+		BP_CloseCellDoor();
+	}
+}
+
+
+bool ADCellDoor::StartCellDoorMotion(UCurveFloat* MotionCurve)
+{
+	if (!MotionCurve) return false;
+
+	UDCellDoorMotionSubsystem* MotionSubsystem = GetWorld()->GetSubsystem<UDCellDoorMotionSubsystem>();
+	if (!MotionSubsystem) return false;
+
+	ActiveMotionCurve = MotionCurve;
+	MotionTime = 0.f;
+	MotionSubsystem->AddMovingCellDoor(this);
+
+	return true;
+}
+
+
+bool ADCellDoor::UpdateCellDoorMotion(float DeltaTime)
+{
+	if (!ActiveMotionCurve) return false;
+
+	float MinTime = 0.f;
+	float MaxTime = 0.f;
+	ActiveMotionCurve->GetTimeRange(MinTime, MaxTime);
+
+	// Last update lands exactly on the curve end
+	const float Duration = MaxTime - MinTime;
+	MotionTime = FMath::Min(MotionTime + DeltaTime, Duration);
+	SetCellDoorHeightOffset(ActiveMotionCurve->GetFloatValue(MinTime + MotionTime));
+
+	return MotionTime < Duration;
+}
+
+
+void ADCellDoor::FinishCellDoorMotion()
+{
+	ActiveMotionCurve = nullptr;
+
+	if (CellDoorState == ECellDoorState::ECDS_Opening)
+	{
+		OnFinishCellDoorOpened();
+	}
+	else if (CellDoorState == ECellDoorState::ECDS_Closing)
+	{
+		OnFinishedCellDoorClosed();
+	}
 }
 
 
 void ADCellDoor::OnUpdateCellDoorHeight(float CellDoorHeightOffset)
+{
+	SetCellDoorHeightOffset(CellDoorHeightOffset);
+}
+
+
+void ADCellDoor::SetCellDoorHeightOffset(float CellDoorHeightOffset)
 {
 	if (!CellDoorStaticMeshComp) return;
 
@@ -173,6 +277,9 @@ void ADCellDoor::OnFinishCellDoorOpened()
 
 	CellDoorState = ECellDoorState::ECDS_Opened;
 	OnCellDoorStateChange.Broadcast(this, CellDoorState);
+
+	// Weight changes while opening were not acted on
+	ProcessDoorOpenCloseState();
 }
 
 
@@ -180,4 +287,7 @@ void ADCellDoor::OnFinishedCellDoorClosed()
 {
 	CellDoorState = ECellDoorState::ECDS_Closed;
 	OnCellDoorStateChange.Broadcast(this, CellDoorState);
+
+	// Weight changes while closing were not acted on
+	ProcessDoorOpenCloseState();
 }
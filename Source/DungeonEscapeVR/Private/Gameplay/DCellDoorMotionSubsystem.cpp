@@ -0,0 +1,73 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Gameplay/DCellDoorMotionSubsystem.h"
+
+// Engine Includes
+#include "Engine/World.h"
+
+// Game Includes
+#include "../DungeonEscapeVR.h"
+#include "Gameplay/DCellDoor.h"
+
+
+DECLARE_CYCLE_STAT(TEXT("Cell Door Motion"), STAT_CellDoorMotion, STATGROUP_DungeonEscapeVR);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cell Doors Moving"), STAT_CellDoorsMoving, STATGROUP_DungeonEscapeVR);
+
+
+void UDCellDoorMotionSubsystem::AddMovingCellDoor(ADCellDoor* CellDoor)
+{
+	if (CellDoor)
+	{
+		MovingCellDoors.AddUnique(CellDoor);
+	}
+}
+
+
+void UDCellDoorMotionSubsystem::RemoveMovingCellDoor(ADCellDoor* CellDoor)
+{
+	MovingCellDoors.RemoveSingleSwap(CellDoor, false);
+}
+
+
+void UDCellDoorMotionSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CellDoorMotion);
+	INC_DWORD_STAT_BY(STAT_CellDoorsMoving, MovingCellDoors.Num());
+
+	TArray<ADCellDoor*, TInlineAllocator<8>> FinishedCellDoors;
+
+	for (int32 i = MovingCellDoors.Num() - 1; i >= 0; --i)
+	{
+		ADCellDoor* CellDoor = MovingCellDoors[i].Get();
+		if (!CellDoor)
+		{
+			MovingCellDoors.RemoveAtSwap(i, 1, false);
+			continue;
+		}
+
+		if (!CellDoor->UpdateCellDoorMotion(DeltaTime))
+		{
+			MovingCellDoors.RemoveAtSwap(i, 1, false);
+			FinishedCellDoors.Add(CellDoor);
+		}
+	}
+
+	// Finishing may start the door moving again, MovingCellDoors is no longer iterated
+	for (ADCellDoor* CellDoor : FinishedCellDoors)
+	{
+		CellDoor->FinishCellDoorMotion();
+	}
+}
+
+
+ETickableTickType UDCellDoorMotionSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+
+TStatId UDCellDoorMotionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDCellDoorMotionSubsystem, STATGROUP_Tickables);
+}
@@ -33,7 +33,7 @@ ADCellDoorTrigger::ADCellDoorTrigger()
 	BoxComp->SetupAttachment(GetRootComponent());
 	BoxComp->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
 
-	CellDoorKeyTag = FName("CellDoorKey");
+	WeightOnTrigger = 0.f;
 }
 
 
@@ -50,50 +50,61 @@ void ADCellDoorTrigger::BeginPlay()
 }
 
 
-float ADCellDoorTrigger::GetWeightOnTrigger() const
+void ADCellDoorTrigger::OnBoxCompBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
-	float TotalWeight = 0.f;
-
-	// Add together weight of all CellDoorKeys
-	for (const auto& Key : CellDoorKeys)
+	if (OtherActor)
 	{
-		// Do not include keys if they are pickup up by the player regardless if key is in CellDoorKeys TArray 
-		if (!Key->GetIsPickedUp())
+		// if overlapping actor is a cell door key and is not already in CellDoorKeys, add to CellDoorKeys. Overlap fires per overlapping component
+		ADInteractableActor* InteractableActor = Cast<ADInteractableActor>(OtherActor);
+		if (InteractableActor && InteractableActor->IsCellDoorKey())
 		{
-			UPrimitiveComponent* PrimativeComp = Key->FindComponentByClass<UPrimitiveComponent>();
-			if (PrimativeComp)
+			bool bAlreadyOnTrigger = false;
+			CellDoorKeys.Add(InteractableActor, &bAlreadyOnTrigger);
+			if (bAlreadyOnTrigger) return;
+
+			InteractableActor->OnPickedUpStateChanged.AddUObject(this, &ADCellDoorTrigger::OnKeyPickedUpStateChanged);
+
+			// Do not include keys if they are pickup up by the player regardless if key is in CellDoorKeys
+			if (!InteractableActor->GetIsPickedUp())
 			{
-				TotalWeight += PrimativeComp->GetMass();
+				WeightOnTrigger += InteractableActor->GetWeight();
 			}
+
+			OnWeightChanged.Broadcast(this);
 		}
 	}
-
-	return TotalWeight;
 }
 
 
-void ADCellDoorTrigger::OnBoxCompBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+void ADCellDoorTrigger::OnBoxCompEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
 {
 	if (OtherActor)
 	{
-		// if overlapping actor is as ADInteractableActor with matching CellDoorKeyTag and is not already in CellDoorKeys array, add to CellDoorKeys
 		ADInteractableActor* InteractableActor = Cast<ADInteractableActor>(OtherActor);
-		if (InteractableActor && InteractableActor->ActorHasTag(CellDoorKeyTag) && !CellDoorKeys.Contains(InteractableActor))
+		if (InteractableActor && CellDoorKeys.Remove(InteractableActor) > 0)
 		{
-			CellDoorKeys.Add(InteractableActor);
+			InteractableActor->OnPickedUpStateChanged.RemoveAll(this);
+
+			if (!InteractableActor->GetIsPickedUp())
+			{
+				WeightOnTrigger -= InteractableActor->GetWeight();
+			}
+
+			// No float drift once the trigger is empty
+			if (CellDoorKeys.Num() == 0)
+			{
+				WeightOnTrigger = 0.f;
+			}
+
+			OnWeightChanged.Broadcast(this);
 		}
 	}
 }
 
 
-void ADCellDoorTrigger::OnBoxCompEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+void ADCellDoorTrigger::OnKeyPickedUpStateChanged(ADInteractableActor* Key, bool bIsPickedUp)
 {
-	if (OtherActor)
-	{
-		ADInteractableActor* InteractableActor = Cast<ADInteractableActor>(OtherActor);
-		if (InteractableActor && CellDoorKeys.Contains(InteractableActor))
-		{
-			CellDoorKeys.Remove(InteractableActor);
-		}
-	}
+	WeightOnTrigger += bIsPickedUp ? -Key->GetWeight() : Key->GetWeight();
+
+	OnWeightChanged.Broadcast(this);
 }
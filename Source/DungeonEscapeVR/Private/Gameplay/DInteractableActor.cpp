@@ -7,25 +7,26 @@
 // Engine Includes
 #include "Components/SphereComponent.h"
 #include "Components/StaticMeshComponent.h"
-#include "Kismet/GameplayStatics.h"
-#include "Kismet/KismetSystemLibrary.h"
 #include "PhysicsEngine/PhysicsConstraintComponent.h"
 
 
 // Game Includes
-#include "Player/DVRPlayerCharacter.h"
+#include "Gameplay/DInteractableOutlineSubsystem.h"
+#include "Gameplay/DInteractableProximitySubsystem.h"
 
 
 static const int32 ENABLE_OUTLINE_STENCIL = 2;
 static const int32 DISABLE_OUTLINE_STENCIL = 0;
 
+/** Cell door keys used to be identified by tag, see bIsCellDoorKey */
+static const FName CELL_DOOR_KEY_TAG = FName("CellDoorKey");
+
 
 // Sets default values
 ADInteractableActor::ADInteractableActor()
 {
-	// Set this pawn to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
-	PrimaryActorTick.TickInterval = 1.f;
+	// Outline is decided by UDInteractableOutlineSubsystem, nothing to tick
+	PrimaryActorTick.bCanEverTick = false;
 
 	MeshComp = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("MeshComp"));
 	SetRootComponent(MeshComp);
@@ -46,7 +47,18 @@ ADInteractableActor::ADInteractableActor()
 	
 	InteractionAlertTrigger = nullptr;
 	bOutlineEnabled = false;
-	bPlayerCharacterTeleporting = false;
+}
+
+
+void ADInteractableActor::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	// Before any BeginPlay, a ADCellDoorTrigger may see this actor in its initial overlaps before this actor begins play
+	if (!bIsCellDoorKey && ActorHasTag(CELL_DOOR_KEY_TAG))
+	{
+		bIsCellDoorKey = true;
+	}
 }
 
 
@@ -55,14 +67,27 @@ void ADInteractableActor::BeginPlay()
 {
 	Super::BeginPlay();
 	
-	if (InteractionAlertSphereComp)
+	UDInteractableProximitySubsystem* ProximitySubsystem = GetWorld()->GetSubsystem<UDInteractableProximitySubsystem>();
+	bUseProximityService = bUseProximityService && ProximitySubsystem && InteractionAlertSphereComp;
+	if (bUseProximityService)
+	{
+		// Moving simulated props pay for overlap updates, proximity service only checks player's head and hands. MeshComp overlaps
+		// are turned back on near the player, see BeginInteractionAlert()
+		InteractionAlertSphereComp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		InteractionAlertSphereComp->SetGenerateOverlapEvents(false);
+		if (MeshComp)
+		{
+			MeshComp->SetGenerateOverlapEvents(false);
+		}
+
+		ProximitySubsystem->RegisterInteractable(this, InteractionAlertSphereComp->GetScaledSphereRadius());
+	}
+	else if (InteractionAlertSphereComp)
 	{
 		InteractionAlertSphereComp->OnComponentBeginOverlap.AddDynamic(this, &ADInteractableActor::OnInteractionAlertSphereCompBeginOverlap);
 		InteractionAlertSphereComp->OnComponentEndOverlap.AddDynamic(this, &ADInteractableActor::OnInteractionAlertSphereCompEndOverlap);
 	}
 
-	BindPlayerPawnTeleportEvents();
-
 	if (MeshComp)
 	{
 		MeshComp->SetMassOverrideInKg(NAME_None, Weight, true);
@@ -70,79 +95,43 @@ void ADInteractableActor::BeginPlay()
 }
 
 
-void ADInteractableActor::BindPlayerPawnTeleportEvents()
+void ADInteractableActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	ADVRPlayerCharacter* VRPlayerCharacter = Cast<ADVRPlayerCharacter>(UGameplayStatics::GetPlayerCharacter(GetWorld(), 0));
-	if (VRPlayerCharacter)
+	if (UDInteractableOutlineSubsystem* OutlineSubsystem = GetOutlineSubsystem())
 	{
-		VRPlayerCharacter->OnPlayerBeginTeleport.AddDynamic(this, &ADInteractableActor::OnPlayerBeingTeleport);
-		VRPlayerCharacter->OnPlayerFinishTeleport.AddDynamic(this, &ADInteractableActor::OnPlayerFinishTeleport);
+		OutlineSubsystem->RemoveOutlineCandidate(this);
 	}
-}
-
 
-void ADInteractableActor::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
+	if (UDInteractableProximitySubsystem* ProximitySubsystem = GetWorld()->GetSubsystem<UDInteractableProximitySubsystem>())
+	{
+		ProximitySubsystem->UnregisterInteractable(this);
+	}
 
-	ProcessShowMeshOutline();
+	Super::EndPlay(EndPlayReason);
 }
 
 
 /*******************************************************************/
 /* Mesh Outline */
 /*******************************************************************/
-void ADInteractableActor::ProcessShowMeshOutline()
+UDInteractableOutlineSubsystem* ADInteractableActor::GetOutlineSubsystem() const
 {
-	if (InteractionAlertTrigger)
-	{
-		const bool bUnobstructedView = UnobstructedViewToInteractionAlertTrigger();
-		if (bUnobstructedView && !bOutlineEnabled && !bPlayerCharacterTeleporting && !bIsPickedUp)
-		{
-			SetEnableMeshCompOutline(true);
-		}
-		else if ((!bUnobstructedView && bOutlineEnabled) || bPlayerCharacterTeleporting || bIsPickedUp)
-		{
-			SetEnableMeshCompOutline(false);
-		}
-	}
-	else if (bOutlineEnabled)
-	{
-		SetEnableMeshCompOutline(false);
-	}
+	UWorld* World = GetWorld();
+	return World ? World->GetSubsystem<UDInteractableOutlineSubsystem>() : nullptr;
 }
 
 
-bool ADInteractableActor::UnobstructedViewToInteractionAlertTrigger() const
+FVector ADInteractableActor::GetInteractionAlertLocation() const
 {
-	bool bUnobstructedView = true;
-	if (InteractionAlertTrigger && InteractionAlertSphereComp)
-	{
-		TArray<AActor*> IgnoreActors;
-
-		IgnoreActors.Add(InteractionAlertTrigger->GetOwner());
-		IgnoreActors.Add(InteractionAlertSphereComp->GetOwner());
-		FHitResult HitResult;
-
-		bUnobstructedView = !UKismetSystemLibrary::LineTraceSingle(
-			GetWorld(),
-			InteractionAlertSphereComp->GetComponentLocation(),
-			InteractionAlertTrigger->GetComponentLocation(),
-			UEngineTypes::ConvertToTraceType(ECollisionChannel::ECC_Visibility),
-			false,
-			IgnoreActors,
-			EDrawDebugTrace::None,
-			HitResult,
-			true
-		);
-	}
-	
-	return bUnobstructedView;
+	return InteractionAlertSphereComp ? InteractionAlertSphereComp->GetComponentLocation() : GetActorLocation();
 }
 
 
 void ADInteractableActor::SetEnableMeshCompOutline(bool Enable)
 {
+	// SetRenderCustomDepth recreates render state, only flip on change
+	if (Enable == bOutlineEnabled) return;
+
 	if (MeshComp)
 	{
 		MeshComp->SetRenderCustomDepth(Enable);
@@ -157,29 +146,49 @@ void ADInteractableActor::SetEnableMeshCompOutline(bool Enable)
 
 void ADInteractableActor::OnInteractionAlertSphereCompBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
-	InteractionAlertTrigger = OtherComp;
+	BeginInteractionAlert(OtherComp);
 }
 
 
 void ADInteractableActor::OnInteractionAlertSphereCompEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
 {
-	if (OtherComp == InteractionAlertTrigger)
-	{
-		InteractionAlertTrigger = nullptr;
-	}
+	EndInteractionAlert(OtherComp);
 }
 
 
-void ADInteractableActor::OnPlayerBeingTeleport()
+void ADInteractableActor::BeginInteractionAlert(UPrimitiveComponent* Trigger)
 {
-	SetEnableMeshCompOutline(false);
-	bPlayerCharacterTeleporting = true;
+	InteractionAlertTrigger = Trigger;
+
+	// Hands find grab candidates from overlaps
+	if (bUseProximityService && MeshComp)
+	{
+		MeshComp->SetGenerateOverlapEvents(true);
+	}
+
+	if (UDInteractableOutlineSubsystem* OutlineSubsystem = GetOutlineSubsystem())
+	{
+		OutlineSubsystem->AddOutlineCandidate(this, InteractionAlertTrigger);
+	}
 }
 
 
-void ADInteractableActor::OnPlayerFinishTeleport()
+void ADInteractableActor::EndInteractionAlert(UPrimitiveComponent* Trigger)
 {
-	bPlayerCharacterTeleporting = false;
+	if (Trigger == InteractionAlertTrigger)
+	{
+		InteractionAlertTrigger = nullptr;
+
+		if (bUseProximityService && MeshComp)
+		{
+			MeshComp->SetGenerateOverlapEvents(false);
+		}
+
+		if (UDInteractableOutlineSubsystem* OutlineSubsystem = GetOutlineSubsystem())
+		{
+			OutlineSubsystem->RemoveOutlineCandidate(this);
+		}
+	}
 }
 
 
@@ -188,13 +197,22 @@ void ADInteractableActor::OnPlayerFinishTeleport()
 /*******************************************************************/
 void ADInteractableActor::GrabActor()
 {
-	bIsPickedUp = true;
 	SetEnableMeshCompOutline(false);
+
+	if (!bIsPickedUp)
+	{
+		bIsPickedUp = true;
+		OnPickedUpStateChanged.Broadcast(this, bIsPickedUp);
+	}
 }
 
 
 void ADInteractableActor::ReleaseActor()
 {
-	bIsPickedUp = false;
+	if (bIsPickedUp)
+	{
+		bIsPickedUp = false;
+		OnPickedUpStateChanged.Broadcast(this, bIsPickedUp);
+	}
 }
 
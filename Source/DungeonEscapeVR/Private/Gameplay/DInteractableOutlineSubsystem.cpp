@@ -0,0 +1,202 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Gameplay/DInteractableOutlineSubsystem.h"
+
+// Engine Includes
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+
+// Game Includes
+#include "../DungeonEscapeVR.h"
+#include "Gameplay/DInteractableActor.h"
+
+
+DECLARE_CYCLE_STAT(TEXT("Interactable Outlines"), STAT_InteractableOutlines, STATGROUP_DungeonEscapeVR);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Outline Traces Issued"), STAT_OutlineTracesIssued, STATGROUP_DungeonEscapeVR);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Outline Changes"), STAT_OutlineChanges, STATGROUP_DungeonEscapeVR);
+
+
+UDInteractableOutlineSubsystem::UDInteractableOutlineSubsystem()
+{
+	MaxOutlineTracesPerFrame = 4;
+	MinOutlineTraceInterval = 0.1f;
+	NextCandidateId = 1;
+	bPlayerTeleporting = false;
+	OutlineTraceDelegate.BindUObject(this, &UDInteractableOutlineSubsystem::OnOutlineTraceCompleted);
+}
+
+
+void UDInteractableOutlineSubsystem::AddOutlineCandidate(ADInteractableActor* Interactable, UPrimitiveComponent* Trigger)
+{
+	if (!Interactable || !Trigger) return;
+
+	FOutlineCandidate* Candidate = OutlineCandidates.FindByPredicate([Interactable](const FOutlineCandidate& OutlineCandidate) { return OutlineCandidate.Interactable == Interactable; });
+	if (!Candidate)
+	{
+		Candidate = &OutlineCandidates.AddDefaulted_GetRef();
+		Candidate->Interactable = Interactable;
+	}
+
+	// New id so a trace still in flight for the previous trigger is dropped. Traced on the next frame
+	Candidate->Id = NextCandidateId++;
+	Candidate->Trigger = Trigger;
+	Candidate->LastTraceTime = -MAX_FLT;
+	Candidate->bTracePending = false;
+}
+
+
+void UDInteractableOutlineSubsystem::RemoveOutlineCandidate(ADInteractableActor* Interactable)
+{
+	OutlineCandidates.RemoveAllSwap([Interactable](const FOutlineCandidate& OutlineCandidate) { return OutlineCandidate.Interactable == Interactable; }, false);
+	HideOutline(Interactable);
+}
+
+
+void UDInteractableOutlineSubsystem::HideOutline(ADInteractableActor* Interactable)
+{
+	if (Interactable)
+	{
+		PendingOutlineChanges.Remove(Interactable);
+		Interactable->SetEnableMeshCompOutline(false);
+	}
+}
+
+
+void UDInteractableOutlineSubsystem::SetPlayerTeleporting(bool bTeleporting)
+{
+	bPlayerTeleporting = bTeleporting;
+	if (!bPlayerTeleporting) return;
+
+	// Only candidates can have an outline
+	PendingOutlineChanges.Reset();
+	for (const FOutlineCandidate& Candidate : OutlineCandidates)
+	{
+		if (ADInteractableActor* Interactable = Candidate.Interactable.Get())
+		{
+			Interactable->SetEnableMeshCompOutline(false);
+		}
+	}
+}
+
+
+void UDInteractableOutlineSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_InteractableOutlines);
+
+	ApplyOutlineChanges();
+
+	if (!bPlayerTeleporting)
+	{
+		IssueOutlineTraces();
+	}
+}
+
+
+void UDInteractableOutlineSubsystem::IssueOutlineTraces()
+{
+	UWorld* World = GetWorld();
+	const float CurrentTime = World->GetTimeSeconds();
+
+	// Score candidates that are due a trace. Longer since last trace and closer to the trigger goes first
+	TArray<TPair<float, int32>, TInlineAllocator<32>> DueCandidates;
+	for (int32 i = OutlineCandidates.Num() - 1; i >= 0; --i)
+	{
+		FOutlineCandidate& Candidate = OutlineCandidates[i];
+		ADInteractableActor* Interactable = Candidate.Interactable.Get();
+		UPrimitiveComponent* Trigger = Candidate.Trigger.Get();
+		if (!Interactable || !Trigger)
+		{
+			OutlineCandidates.RemoveAtSwap(i, 1, false);
+			continue;
+		}
+
+		const float TimeSinceTrace = CurrentTime - Candidate.LastTraceTime;
+		if (Candidate.bTracePending || TimeSinceTrace < MinOutlineTraceInterval) continue;
+
+		const float Distance = FMath::Max(FVector::Dist(Interactable->GetInteractionAlertLocation(), Trigger->GetComponentLocation()), 10.f);
+		DueCandidates.Emplace(FMath::Min(TimeSinceTrace, 10.f) / Distance, i);
+	}
+
+	DueCandidates.Sort([](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key > B.Key; });
+
+	const int32 NumTraces = FMath::Min(DueCandidates.Num(), MaxOutlineTracesPerFrame);
+	for (int32 i = 0; i < NumTraces; ++i)
+	{
+		FOutlineCandidate& Candidate = OutlineCandidates[DueCandidates[i].Value];
+		ADInteractableActor* Interactable = Candidate.Interactable.Get();
+		UPrimitiveComponent* Trigger = Candidate.Trigger.Get();
+
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(InteractableOutline), false);
+		QueryParams.AddIgnoredActor(Interactable);
+		QueryParams.AddIgnoredActor(Trigger->GetOwner());
+
+		World->AsyncLineTraceByChannel(
+			EAsyncTraceType::Single,
+			Interactable->GetInteractionAlertLocation(),
+			Trigger->GetComponentLocation(),
+			ECollisionChannel::ECC_Visibility,
+			QueryParams,
+			FCollisionResponseParams::DefaultResponseParam,
+			&OutlineTraceDelegate,
+			Candidate.Id
+		);
+
+		Candidate.bTracePending = true;
+		Candidate.LastTraceTime = CurrentTime;
+	}
+
+	INC_DWORD_STAT_BY(STAT_OutlineTracesIssued, NumTraces);
+}
+
+
+void UDInteractableOutlineSubsystem::OnOutlineTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	// Candidate removed or trigger changed while trace was in flight
+	FOutlineCandidate* Candidate = OutlineCandidates.FindByPredicate([&TraceDatum](const FOutlineCandidate& OutlineCandidate) { return OutlineCandidate.Id == TraceDatum.UserData; });
+	if (!Candidate) return;
+
+	Candidate->bTracePending = false;
+
+	ADInteractableActor* Interactable = Candidate->Interactable.Get();
+	if (!Interactable) return;
+
+	const bool bUnobstructedView = !(TraceDatum.OutHits.Num() > 0 && TraceDatum.OutHits[0].bBlockingHit);
+	const bool bShowOutline = bUnobstructedView && !bPlayerTeleporting && Interactable->CanShowOutline();
+	if (bShowOutline != Interactable->IsOutlineEnabled())
+	{
+		PendingOutlineChanges.Add(Interactable, bShowOutline);
+	}
+	else
+	{
+		PendingOutlineChanges.Remove(Interactable);
+	}
+}
+
+
+void UDInteractableOutlineSubsystem::ApplyOutlineChanges()
+{
+	for (const TPair<TWeakObjectPtr<ADInteractableActor>, bool>& OutlineChange : PendingOutlineChanges)
+	{
+		ADInteractableActor* Interactable = OutlineChange.Key.Get();
+		if (Interactable && (!OutlineChange.Value || (!bPlayerTeleporting && Interactable->CanShowOutline())))
+		{
+			Interactable->SetEnableMeshCompOutline(OutlineChange.Value);
+			INC_DWORD_STAT(STAT_OutlineChanges);
+		}
+	}
+
+	PendingOutlineChanges.Reset();
+}
+
+
+ETickableTickType UDInteractableOutlineSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+
+TStatId UDInteractableOutlineSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDInteractableOutlineSubsystem, STATGROUP_Tickables);
+}
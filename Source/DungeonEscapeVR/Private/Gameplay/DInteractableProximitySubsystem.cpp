@@ -0,0 +1,257 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Gameplay/DInteractableProximitySubsystem.h"
+
+// Engine Includes
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+
+// Game Includes
+#include "../DungeonEscapeVR.h"
+#include "Gameplay/DInteractableActor.h"
+
+
+DECLARE_CYCLE_STAT(TEXT("Interactable Proximity"), STAT_InteractableProximity, STATGROUP_DungeonEscapeVR);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Proximity Interactables Rehashed"), STAT_ProximityInteractablesRehashed, STATGROUP_DungeonEscapeVR);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Proximity Interactables Alerted"), STAT_ProximityInteractablesAlerted, STATGROUP_DungeonEscapeVR);
+
+
+UDInteractableProximitySubsystem::UDInteractableProximitySubsystem()
+{
+	ProximityCellSize = 100.f;
+	MaxAlertRadius = 0.f;
+}
+
+
+void UDInteractableProximitySubsystem::RegisterInteractable(ADInteractableActor* Interactable, float AlertRadius)
+{
+	if (!Interactable || !Interactable->GetRootComponent() || InteractableIndices.Contains(Interactable)) return;
+
+	FDelegateHandle TransformUpdatedHandle = Interactable->GetRootComponent()->TransformUpdated.AddUObject(this, &UDInteractableProximitySubsystem::OnInteractableTransformUpdated);
+
+	const int32 Index = Interactables.Add({ Interactable, AlertRadius, GetCell(Interactable->GetActorLocation()), TransformUpdatedHandle });
+	InteractableIndices.Add(Interactable, Index);
+	AddToCell(Index);
+
+	MaxAlertRadius = FMath::Max(MaxAlertRadius, AlertRadius);
+}
+
+
+void UDInteractableProximitySubsystem::UnregisterInteractable(ADInteractableActor* Interactable)
+{
+	const int32* Index = InteractableIndices.Find(Interactable);
+	if (Index)
+	{
+		if (USceneComponent* RootComponent = Interactable->GetRootComponent())
+		{
+			RootComponent->TransformUpdated.Remove(Interactables[*Index].TransformUpdatedHandle);
+		}
+
+		RemoveInteractableAt(*Index);
+		AlertedInteractables.Remove(Interactable);
+	}
+}
+
+
+void UDInteractableProximitySubsystem::RemoveInteractableAt(int32 Index)
+{
+	// Last interactable is swapped into Index, move its cell entry with it
+	const int32 LastIndex = Interactables.Num() - 1;
+	RemoveFromCell(Index);
+	if (Index != LastIndex)
+	{
+		RemoveFromCell(LastIndex);
+	}
+
+	// Keys are only compared, the actor may already be destroyed
+	const ADInteractableActor* RemovedInteractable = Interactables[Index].Interactable.Get(true);
+	InteractableIndices.Remove(RemovedInteractable);
+	MovedInteractables.Remove(RemovedInteractable);
+
+	Interactables.RemoveAtSwap(Index, 1, false);
+	if (Index != LastIndex)
+	{
+		AddToCell(Index);
+		InteractableIndices.Add(Interactables[Index].Interactable.Get(true), Index);
+	}
+}
+
+
+void UDInteractableProximitySubsystem::RegisterProximitySource(UPrimitiveComponent* Source)
+{
+	if (Source)
+	{
+		ProximitySources.AddUnique(Source);
+	}
+}
+
+
+void UDInteractableProximitySubsystem::QueryNearbyInteractables(const FVector& Location, TArray<ADInteractableActor*>& OutInteractables) const
+{
+	const FIntVector MinCell = GetCell(Location - FVector(MaxAlertRadius));
+	const FIntVector MaxCell = GetCell(Location + FVector(MaxAlertRadius));
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+			{
+				const TArray<int32>* CellIndices = Cells.Find(FIntVector(X, Y, Z));
+				if (!CellIndices) continue;
+
+				for (const int32 Index : *CellIndices)
+				{
+					const FProximityInteractable& ProximityInteractable = Interactables[Index];
+					ADInteractableActor* Interactable = ProximityInteractable.Interactable.Get();
+					if (Interactable && FVector::DistSquared(Interactable->GetActorLocation(), Location) <= FMath::Square(ProximityInteractable.AlertRadius))
+					{
+						OutInteractables.Add(Interactable);
+					}
+				}
+			}
+		}
+	}
+}
+
+
+void UDInteractableProximitySubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_InteractableProximity);
+
+	UpdateSpatialHash();
+	UpdateAlertedInteractables();
+}
+
+
+/*******************************************************************/
+/* Spatial Hash */
+/*******************************************************************/
+FIntVector UDInteractableProximitySubsystem::GetCell(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt(Location.X / ProximityCellSize),
+		FMath::FloorToInt(Location.Y / ProximityCellSize),
+		FMath::FloorToInt(Location.Z / ProximityCellSize)
+	);
+}
+
+
+void UDInteractableProximitySubsystem::AddToCell(int32 Index)
+{
+	Cells.FindOrAdd(Interactables[Index].Cell).Add(Index);
+}
+
+
+void UDInteractableProximitySubsystem::RemoveFromCell(int32 Index)
+{
+	const FIntVector Cell = Interactables[Index].Cell;
+	if (TArray<int32>* CellIndices = Cells.Find(Cell))
+	{
+		CellIndices->RemoveSingleSwap(Index, false);
+		if (CellIndices->Num() == 0)
+		{
+			Cells.Remove(Cell);
+		}
+	}
+}
+
+
+void UDInteractableProximitySubsystem::UpdateSpatialHash()
+{
+	for (const ADInteractableActor* MovedInteractable : MovedInteractables)
+	{
+		const int32* Index = InteractableIndices.Find(MovedInteractable);
+		if (!Index) continue;
+
+		FProximityInteractable& ProximityInteractable = Interactables[*Index];
+		const ADInteractableActor* Interactable = ProximityInteractable.Interactable.Get();
+		if (!Interactable) continue;
+
+		// Only rehash when the cell changes
+		const FIntVector Cell = GetCell(Interactable->GetActorLocation());
+		if (Cell != ProximityInteractable.Cell)
+		{
+			RemoveFromCell(*Index);
+			ProximityInteractable.Cell = Cell;
+			AddToCell(*Index);
+			INC_DWORD_STAT(STAT_ProximityInteractablesRehashed);
+		}
+	}
+
+	MovedInteractables.Reset();
+}
+
+
+void UDInteractableProximitySubsystem::OnInteractableTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	// Only bound to interactables' root components
+	MovedInteractables.Add(static_cast<const ADInteractableActor*>(UpdatedComponent->GetOwner()));
+}
+
+
+void UDInteractableProximitySubsystem::UpdateAlertedInteractables()
+{
+	ProximitySources.RemoveAllSwap([](const TWeakObjectPtr<UPrimitiveComponent>& Source) { return !Source.IsValid(); }, false);
+
+	// Nearest source of each nearby interactable
+	TMap<ADInteractableActor*, TPair<UPrimitiveComponent*, float>> NearbyInteractables;
+	TArray<ADInteractableActor*> QueryResults;
+	for (const TWeakObjectPtr<UPrimitiveComponent>& SourcePtr : ProximitySources)
+	{
+		UPrimitiveComponent* Source = SourcePtr.Get();
+		const FVector SourceLocation = Source->GetComponentLocation();
+
+		QueryResults.Reset();
+		QueryNearbyInteractables(SourceLocation, QueryResults);
+		for (ADInteractableActor* Interactable : QueryResults)
+		{
+			const float DistanceSquared = FVector::DistSquared(Interactable->GetActorLocation(), SourceLocation);
+			TPair<UPrimitiveComponent*, float>* Nearest = NearbyInteractables.Find(Interactable);
+			if (!Nearest || DistanceSquared < Nearest->Value)
+			{
+				NearbyInteractables.Add(Interactable, TPair<UPrimitiveComponent*, float>(Source, DistanceSquared));
+			}
+		}
+	}
+
+	// Interactables no longer near any source
+	for (auto It = AlertedInteractables.CreateIterator(); It; ++It)
+	{
+		ADInteractableActor* Interactable = It.Key().Get();
+		if (!Interactable || !NearbyInteractables.Contains(Interactable))
+		{
+			if (Interactable)
+			{
+				Interactable->EndInteractionAlert(It.Value().Get());
+			}
+			It.RemoveCurrent();
+		}
+	}
+
+	// Interactables newly near a source, or nearest to a different source
+	for (const TPair<ADInteractableActor*, TPair<UPrimitiveComponent*, float>>& NearbyInteractable : NearbyInteractables)
+	{
+		TWeakObjectPtr<UPrimitiveComponent>& Trigger = AlertedInteractables.FindOrAdd(NearbyInteractable.Key);
+		if (Trigger.Get() != NearbyInteractable.Value.Key)
+		{
+			Trigger = NearbyInteractable.Value.Key;
+			NearbyInteractable.Key->BeginInteractionAlert(NearbyInteractable.Value.Key);
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_ProximityInteractablesAlerted, NearbyInteractables.Num());
+}
+
+
+ETickableTickType UDInteractableProximitySubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+
+TStatId UDInteractableProximitySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDInteractableProximitySubsystem, STATGROUP_Tickables);
+}
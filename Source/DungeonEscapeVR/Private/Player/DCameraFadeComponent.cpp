@@ -0,0 +1,167 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Player/DCameraFadeComponent.h"
+
+// Engine Includes
+#include "Engine/GameViewportClient.h"
+#include "Engine/World.h"
+#include "RenderingThread.h"
+#include "SceneView.h"
+#include "SceneViewExtension.h"
+
+// Game Includes
+#include "../DungeonEscapeVR.h"
+
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Camera Fades Sent"), STAT_CameraFadesSent, STATGROUP_DungeonEscapeVR);
+
+
+/**
+ * Applies UDCameraFadeComponent fades to views of the owning world's game viewport. Fade states are only written and read on the render thread,
+ * the alpha is evaluated from timestamps each view so the game thread does not take part in fading
+ */
+class FDCameraFadeViewExtension : public FSceneViewExtensionBase
+{
+
+public:
+
+	FDCameraFadeViewExtension(const FAutoRegister& AutoRegister, UWorld* InWorld)
+		: FSceneViewExtensionBase(AutoRegister)
+		, World(InWorld)
+	{
+	}
+
+	void SetFadeState_RenderThread(int32 Channel, const FCameraFadeState& FadeState)
+	{
+		check(IsInRenderingThread());
+		FadeStates_RenderThread[Channel] = FadeState;
+	}
+
+	/** ISceneViewExtension */
+	virtual void SetupViewFamily(FSceneViewFamily& InViewFamily) override {}
+	virtual void SetupView(FSceneViewFamily& InViewFamily, FSceneView& InView) override {}
+	virtual void BeginRenderViewFamily(FSceneViewFamily& InViewFamily) override {}
+	virtual void PreRenderViewFamily_RenderThread(FRHICommandListImmediate& RHICmdList, FSceneViewFamily& InViewFamily) override {}
+
+	virtual void PreRenderView_RenderThread(FRHICommandListImmediate& RHICmdList, FSceneView& InView) override
+	{
+		const double CurrentTime = FPlatformTime::Seconds();
+
+		// Channel with the highest alpha fades the view
+		float Alpha = 0.f;
+		FLinearColor Color = FLinearColor::Black;
+		for (const FCameraFadeState& FadeState : FadeStates_RenderThread)
+		{
+			const float ChannelAlpha = FadeState.GetAlpha(CurrentTime);
+			if (ChannelAlpha > Alpha)
+			{
+				Alpha = ChannelAlpha;
+				Color = FadeState.Color;
+			}
+		}
+
+		if (Alpha > InView.OverlayColor.A)
+		{
+			InView.OverlayColor = Color;
+			InView.OverlayColor.A = FMath::Clamp(Alpha, 0.f, 1.f);
+		}
+	}
+
+	virtual bool IsActiveThisFrame(FViewport* InViewport) const override
+	{
+		UGameViewportClient* GameViewport = World.IsValid() ? World->GetGameViewport() : nullptr;
+		return GameViewport && GameViewport->Viewport == InViewport;
+	}
+
+
+private:
+
+	TWeakObjectPtr<UWorld> World;
+
+	FCameraFadeState FadeStates_RenderThread[static_cast<int32>(ECameraFadeChannel::ECFC_MAX)];
+
+};
+
+
+UDCameraFadeComponent::UDCameraFadeComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+
+void UDCameraFadeComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	UWorld* World = GetWorld();
+	if (World && World->IsGameWorld() && !ViewExtension.IsValid())
+	{
+		ViewExtension = FSceneViewExtensions::NewExtension<FDCameraFadeViewExtension>(World);
+
+		// Component may be re-registered mid fade
+		for (int32 Channel = 0; Channel < static_cast<int32>(ECameraFadeChannel::ECFC_MAX); ++Channel)
+		{
+			SendFadeState(static_cast<ECameraFadeChannel>(Channel));
+		}
+	}
+}
+
+
+void UDCameraFadeComponent::OnUnregister()
+{
+	// Scene view extensions are held weakly, releasing the last reference unregisters it. Render thread keeps its own reference while in use
+	ViewExtension.Reset();
+
+	Super::OnUnregister();
+}
+
+
+void UDCameraFadeComponent::StartFade(ECameraFadeChannel Channel, float FromAlpha, float ToAlpha, float Duration, const FLinearColor& Color)
+{
+	FCameraFadeState& FadeState = FadeStates[static_cast<int32>(Channel)];
+	FadeState.StartAlpha = FMath::Clamp(FromAlpha, 0.f, 1.f);
+	FadeState.TargetAlpha = FMath::Clamp(ToAlpha, 0.f, 1.f);
+	FadeState.StartTime = FPlatformTime::Seconds();
+	FadeState.Duration = FMath::Max(Duration, 0.f);
+	FadeState.Color = Color;
+
+	SendFadeState(Channel);
+}
+
+
+void UDCameraFadeComponent::FadeTo(ECameraFadeChannel Channel, float ToAlpha, float Rate, const FLinearColor& Color)
+{
+	const FCameraFadeState& FadeState = FadeStates[static_cast<int32>(Channel)];
+	ToAlpha = FMath::Clamp(ToAlpha, 0.f, 1.f);
+
+	// Already fading there, restarting would only send the same fade again
+	if (FadeState.TargetAlpha == ToAlpha && FadeState.Color.Equals(Color)) return;
+
+	const float FromAlpha = GetFadeAlpha(Channel);
+	const float Duration = Rate > 0.f ? FMath::Abs(ToAlpha - FromAlpha) / Rate : 0.f;
+	StartFade(Channel, FromAlpha, ToAlpha, Duration, Color);
+}
+
+
+float UDCameraFadeComponent::GetFadeAlpha(ECameraFadeChannel Channel) const
+{
+	return FadeStates[static_cast<int32>(Channel)].GetAlpha(FPlatformTime::Seconds());
+}
+
+
+void UDCameraFadeComponent::SendFadeState(ECameraFadeChannel Channel) const
+{
+	if (!ViewExtension.IsValid()) return;
+
+	INC_DWORD_STAT(STAT_CameraFadesSent);
+
+	TSharedPtr<FDCameraFadeViewExtension, ESPMode::ThreadSafe> Extension = ViewExtension;
+	const int32 ChannelIndex = static_cast<int32>(Channel);
+	const FCameraFadeState FadeState = FadeStates[ChannelIndex];
+	ENQUEUE_RENDER_COMMAND(SetCameraFadeState)(
+		[Extension, ChannelIndex, FadeState](FRHICommandListImmediate& RHICmdList)
+		{
+			Extension->SetFadeState_RenderThread(ChannelIndex, FadeState);
+		});
+}
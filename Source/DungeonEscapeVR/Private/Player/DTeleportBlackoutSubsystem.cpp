@@ -0,0 +1,194 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Player/DTeleportBlackoutSubsystem.h"
+
+// Engine Includes
+#include "Engine/Engine.h"
+#include "Engine/LevelStreaming.h"
+#include "Engine/World.h"
+#include "UObject/GarbageCollection.h"
+#include "UObject/UObjectGlobals.h"
+
+// Game Includes
+#include "../DungeonEscapeVR.h"
+
+
+DECLARE_CYCLE_STAT(TEXT("Teleport Blackout Work"), STAT_TeleportBlackoutWork, STATGROUP_DungeonEscapeVR);
+
+
+UDTeleportBlackoutSubsystem::UDTeleportBlackoutSubsystem()
+{
+	BlackoutFrameBudget = 8.f;
+	bCollectGarbageInBlackout = true;
+	bAdvanceLevelStreamingInBlackout = true;
+	LevelStreamingBlackoutTimeout = 2.f;
+	bBlackoutWindowOpen = false;
+	BlackoutWindowOpenTime = 0.f;
+	BlackoutStartTime = 0.f;
+	GarbageCollectionRequestFrame = 0;
+	LevelStreamingWorkStartTime = 0.0;
+}
+
+
+void UDTeleportBlackoutSubsystem::QueueBlackoutWork(FName Name, const FBlackoutWorkDelegate& Work)
+{
+	if (!Work.IsBound()) return;
+
+	const bool bAlreadyQueued = QueuedWork.ContainsByPredicate([Name](const FBlackoutWork& QueuedBlackoutWork) { return QueuedBlackoutWork.Name == Name; });
+	if (!bAlreadyQueued)
+	{
+		QueuedWork.Add({ Name, Work });
+	}
+}
+
+
+void UDTeleportBlackoutSubsystem::OpenBlackoutWindow(float BlackoutDelay)
+{
+	if (bBlackoutWindowOpen) return;
+
+	bBlackoutWindowOpen = true;
+	BlackoutWindowOpenTime = GetWorld()->GetTimeSeconds();
+	BlackoutStartTime = BlackoutWindowOpenTime + BlackoutDelay;
+	BlackoutReport = FTeleportBlackoutReport();
+
+	// Streaming first, levels it unloads are then collected
+	if (bAdvanceLevelStreamingInBlackout)
+	{
+		LevelStreamingWorkStartTime = 0.0;
+		QueueBlackoutWork(TEXT("AdvanceLevelStreaming"), FBlackoutWorkDelegate::CreateUObject(this, &UDTeleportBlackoutSubsystem::AdvanceLevelStreamingWork));
+	}
+
+	if (bCollectGarbageInBlackout)
+	{
+		GarbageCollectionRequestFrame = 0;
+		QueueBlackoutWork(TEXT("GarbageCollection"), FBlackoutWorkDelegate::CreateUObject(this, &UDTeleportBlackoutSubsystem::CollectGarbageWork));
+	}
+}
+
+
+void UDTeleportBlackoutSubsystem::CloseBlackoutWindow()
+{
+	if (!bBlackoutWindowOpen) return;
+
+	bBlackoutWindowOpen = false;
+	BlackoutReport.WorkRemaining = QueuedWork.Num();
+	BlackoutReport.WindowDuration = GetWorld()->GetTimeSeconds() - BlackoutWindowOpenTime;
+	LastBlackoutReport = BlackoutReport;
+
+	UE_LOG(LogDungeonEscapeVR, Log, TEXT("Teleport blackout: %d work finished, %d remaining, %.2f ms over %d frames in %.2f s window"),
+		BlackoutReport.WorkFinished, BlackoutReport.WorkRemaining, BlackoutReport.WorkTime * 1000.0, BlackoutReport.FramesRun, BlackoutReport.WindowDuration);
+}
+
+
+void UDTeleportBlackoutSubsystem::Tick(float DeltaTime)
+{
+	// Camera still fading out, work would hitch visible frames
+	if (QueuedWork.Num() == 0 || GetWorld()->GetTimeSeconds() < BlackoutStartTime) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_TeleportBlackoutWork);
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double EndTime = StartTime + BlackoutFrameBudget / 1000.0;
+
+	// Work is removed once finished, work that is not finished yet stops this frame's work to keep order
+	double CurrentTime = StartTime;
+	while (QueuedWork.Num() > 0 && CurrentTime < EndTime)
+	{
+		// Object the work was bound to has been destroyed
+		if (!QueuedWork[0].Work.IsBound())
+		{
+			QueuedWork.RemoveAt(0, 1, false);
+			continue;
+		}
+
+		const bool bFinished = QueuedWork[0].Work.Execute(EndTime - CurrentTime);
+		CurrentTime = FPlatformTime::Seconds();
+
+		if (!bFinished) break;
+
+		QueuedWork.RemoveAt(0, 1, false);
+		++BlackoutReport.WorkFinished;
+	}
+
+	++BlackoutReport.FramesRun;
+	BlackoutReport.WorkTime += CurrentTime - StartTime;
+}
+
+
+ETickableTickType UDTeleportBlackoutSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+
+TStatId UDTeleportBlackoutSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDTeleportBlackoutSubsystem, STATGROUP_Tickables);
+}
+
+
+bool UDTeleportBlackoutSubsystem::CollectGarbageWork(double TimeBudget)
+{
+	// Reachability analysis runs at the end of the frame it is requested on
+	if (GarbageCollectionRequestFrame == 0)
+	{
+		GEngine->ForceGarbageCollection(false);
+		GarbageCollectionRequestFrame = GFrameCounter;
+		return false;
+	}
+
+	if (GFrameCounter == GarbageCollectionRequestFrame) return false;
+
+	// Purge with the blackout budget instead of the engine's small per frame limit
+	if (IsIncrementalPurgePending())
+	{
+		IncrementalPurgeGarbage(true, static_cast<float>(TimeBudget));
+	}
+
+	return !IsIncrementalPurgePending();
+}
+
+
+bool UDTeleportBlackoutSubsystem::AdvanceLevelStreamingWork(double TimeBudget)
+{
+	UWorld* World = GetWorld();
+	World->UpdateLevelStreaming();
+
+	// Only this world's streaming levels are waited for, other async loads, e.g. assets loaded on demand, keep loading in the background
+	if (!IsLevelStreamingPending()) return true;
+
+	const double CurrentTime = FPlatformTime::Seconds();
+	if (LevelStreamingWorkStartTime == 0.0)
+	{
+		LevelStreamingWorkStartTime = CurrentTime;
+	}
+	else if (CurrentTime - LevelStreamingWorkStartTime >= LevelStreamingBlackoutTimeout)
+	{
+		UE_LOG(LogDungeonEscapeVR, Warning, TEXT("Teleport blackout: level streaming still pending after %.1f s, left to normal streaming"), LevelStreamingBlackoutTimeout);
+		return true;
+	}
+
+	// Advance pending loads within the budget rather than blocking on FlushLevelStreaming, a multi-frame stall drops compositor frames
+	if (IsAsyncLoading())
+	{
+		ProcessAsyncLoading(true, false, static_cast<float>(TimeBudget));
+		World->UpdateLevelStreaming();
+	}
+
+	return !IsLevelStreamingPending();
+}
+
+
+bool UDTeleportBlackoutSubsystem::IsLevelStreamingPending() const
+{
+	for (const ULevelStreaming* StreamingLevel : GetWorld()->GetStreamingLevels())
+	{
+		if (StreamingLevel && StreamingLevel->IsStreamingStatePending())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
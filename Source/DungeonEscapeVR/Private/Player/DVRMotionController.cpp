@@ -4,6 +4,7 @@
 #include "Player/DVRMotionController.h"
 
 // Engine Includes
+#include "Components/InstancedStaticMeshComponent.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Components/SphereComponent.h"
 #include "Components/SplineComponent.h"
@@ -11,9 +12,11 @@
 #include "Components/StaticMeshComponent.h"
 #include "Components/WidgetInteractionComponent.h"
 #include "GameFramework/PlayerController.h"
+#include "Haptics/HapticFeedbackEffect_Base.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/GameplayStaticsTypes.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "Materials/Material.h"
 #include "MotionControllerComponent.h"
 #include "NavigationSystem.h"
 #include "PhysicsEngine/PhysicsConstraintComponent.h"
@@ -21,10 +24,24 @@
 
 
 // Game Includes
+#include "../DungeonEscapeVR.h"
 #include "Gameplay/DInteractableActor.h"
+#include "Gameplay/DInteractableProximitySubsystem.h"
 #include "Player/DVRPlayerCharacter.h"
 
 
+DECLARE_CYCLE_STAT(TEXT("UpdateTeleportDestination"), STAT_UpdateTeleportDestination, STATGROUP_DungeonEscapeVR);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Teleport Path Scene Queries"), STAT_TeleportPathSceneQueries, STATGROUP_DungeonEscapeVR);
+// Counts the controller's own calls that dirty TeleportArcMeshComp render state, engine side cost is in stat SceneUpdate
+DECLARE_DWORD_COUNTER_STAT(TEXT("Teleport Arc Mesh Component Updates"), STAT_TeleportArcMeshComponentUpdates, STATGROUP_DungeonEscapeVR);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hand Component Transform Updates"), STAT_HandComponentTransformUpdates, STATGROUP_DungeonEscapeVR);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Haptic Effects Queued"), STAT_HapticEffectsQueued, STATGROUP_DungeonEscapeVR);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Haptic Effects Played"), STAT_HapticEffectsPlayed, STATGROUP_DungeonEscapeVR);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Grabbed Actor Lag (cm)"), STAT_GrabbedActorLag, STATGROUP_DungeonEscapeVR);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pose Gating Hits"), STAT_PoseGatingHits, STATGROUP_DungeonEscapeVR);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pose Gating Misses"), STAT_PoseGatingMisses, STATGROUP_DungeonEscapeVR);
+
+
 const int32 ADVRMotionController::UIINTERACTION_START_INDEX = 0;
 const int32 ADVRMotionController::UIINTERACTION_END_INDEX = 1;
 
@@ -64,8 +81,12 @@ ADVRMotionController::ADVRMotionController()
 	TeleportDestinationMarker->SetupAttachment(GetRootComponent());
 	TeleportDestinationMarker->SetVisibility(false, true);
 
-	TeleportSplinePath = CreateDefaultSubobject<USplineComponent>(TEXT("TeleportSplinePath"));
-	TeleportSplinePath->SetupAttachment(GetRootComponent());
+	TeleportArcMeshComp = CreateDefaultSubobject<UInstancedStaticMeshComponent>(TEXT("TeleportArcMeshComp"));
+	TeleportArcMeshComp->SetupAttachment(GetRootComponent());
+	TeleportArcMeshComp->SetMobility(EComponentMobility::Movable);
+	TeleportArcMeshComp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	TeleportArcMeshComp->SetGenerateOverlapEvents(false);
+	TeleportArcMeshComp->SetVisibility(false);
 
 	UIInteractionSpline = CreateDefaultSubobject<USplineComponent>(TEXT("UIInteractionSpline"));
 	UIInteractionSpline->SetupAttachment(GetRootComponent());
@@ -74,15 +95,47 @@ ADVRMotionController::ADVRMotionController()
 	UIInteractionSplineMesh->SetupAttachment(UIInteractionSpline);
 	UIInteractionSplineMesh->SetMobility(EComponentMobility::Movable);
 	UIInteractionSplineMesh->SetVisibility(false, true);
+
+	UIInteractionBeamMeshComp = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("UIInteractionBeamMeshComp"));
+	UIInteractionBeamMeshComp->SetupAttachment(WidgetInteractionComp);
+	UIInteractionBeamMeshComp->SetMobility(EComponentMobility::Movable);
+	UIInteractionBeamMeshComp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	UIInteractionBeamMeshComp->SetGenerateOverlapEvents(false);
+	UIInteractionBeamMeshComp->SetVisibility(false);
 	
 	bLookForTeleportDestination = false;
 	TeleportProjectileRadius = 10.f;
 	TeleportProjectileSpeed = 800.f;
 	TeleportSimulationTime = 2.f;
 	bTeleportTraceComplex = true;
+	TeleportSimulationFrequency = 15.f;
+	TeleportTraceMode = ETeleportTraceMode::ETTM_Blocking;
+	TeleportTraceQueryCount = 0;
+	TeleportTraceCompletedCount = 0;
+	TeleportTraceDelegate.BindUObject(this, &ADVRMotionController::OnTeleportTraceSegmentCompleted);
+	MaxTeleportArcSegments = 40;
+	bTeleportArcVisible = false;
+	bUseWidgetInteractionHitForUIPointer = false;
+	UIInteractionBeamLength = 0.f;
+	bEnablePoseGating = false;
+	PoseGatingLocationTolerance = 0.5f;
+	PoseGatingRotationTolerance = 0.5f;
+	PoseGatingHitClearance = 20.f;
+	PoseGatingMaxReuseTime = 0.25f;
+	PoseGatingHitCount = 0;
+	PoseGatingMissCount = 0;
 	ControllerMode = EControllerMode::ECM_UI;
 	HandScale = 1.f;
 	CurrentGrabedActor = nullptr;
+	HandTransformUpdateCount = 0;
+	LastFrameHandTransformUpdateCount = 0;
+	bLateUpdateGrabbedActor = false;
+	GrabbedActorLag = 0.f;
+	bApplyReleaseVelocity = true;
+	ReleaseVelocityWindow = 0.1f;
+	HapticMinInterval = 0.1f;
+	PlayingHapticEffectStartTime = -MAX_FLT;
+	PlayingHapticEffectEndTime = 0.f;
 }
 
 
@@ -90,8 +143,56 @@ ADVRMotionController::ADVRMotionController()
 void ADVRMotionController::BeginPlay()
 {
 	Super::BeginPlay();
+
+	// Tick after MotionControllerComp has polled this frame's controller pose. See bLateUpdateGrabbedActor
+	AddTickPrerequisiteComponent(MotionControllerComp);
 	
+	InitTeleportArcMesh();
+	InitUIInteractionSpline();
 	SetControllerMode(ControllerMode);
+
+	// Navmesh rebuilds can move or remove the teleport destination, see bEnablePoseGating
+	if (UNavigationSystemV1* NavigationSystem = UNavigationSystemV1::GetCurrent(GetWorld()))
+	{
+		NavigationSystem->OnNavigationGenerationFinishedDelegate.AddDynamic(this, &ADVRMotionController::OnNavigationGenerationFinished);
+	}
+
+	// Hand alerts interactables using the proximity service
+	if (UDInteractableProximitySubsystem* ProximitySubsystem = GetWorld()->GetSubsystem<UDInteractableProximitySubsystem>())
+	{
+		ProximitySubsystem->RegisterProximitySource(InteractionSphereComp);
+	}
+
+	if (InteractionSphereComp)
+	{
+		InteractionSphereComp->OnComponentBeginOverlap.AddDynamic(this, &ADVRMotionController::OnInteractionSphereCompBeginOverlap);
+		InteractionSphereComp->OnComponentEndOverlap.AddDynamic(this, &ADVRMotionController::OnInteractionSphereCompEndOverlap);
+
+		// Overlaps that started before events were bound
+		TArray<AActor*> OverlappingActors;
+		InteractionSphereComp->GetOverlappingActors(OverlappingActors);
+		for (AActor* Actor : OverlappingActors)
+		{
+			if (IsGrabCandidate(Actor))
+			{
+				GrabCandidates.AddUnique(Actor);
+			}
+		}
+	}
+
+#if !UE_BUILD_SHIPPING
+
+	// Count transform updates of hand hierarchy, see stat DungeonEscapeVR
+	USceneComponent* HandComponents[] = { MeshComp, InteractionSphereComp, PhysicsConstraintComp };
+	for (USceneComponent* HandComponent : HandComponents)
+	{
+		if (HandComponent)
+		{
+			HandComponent->TransformUpdated.AddUObject(this, &ADVRMotionController::OnHandComponentTransformUpdated);
+		}
+	}
+
+#endif
 }
 
 
@@ -100,21 +201,45 @@ void ADVRMotionController::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	UpdateMotionControllerTransform();
+	LastFrameHandTransformUpdateCount = HandTransformUpdateCount;
+	HandTransformUpdateCount = 0;
 
 	if (ControllerMode == EControllerMode::ECM_UI)
 	{
-		UpdateUIInteractionSpline();
+		if (bUseWidgetInteractionHitForUIPointer)
+		{
+			UpdateUIInteractionBeam();
+		}
+		else
+		{
+			UpdateUIInteractionSpline();
+		}
 	}
 	else // ControllerMode == EControllerMode::ECM_Game
 	{
-		UpdateInteractionWithOverlappingActors();
+		if (InteractionSphereComp)
+		{
+			PoseHistory.AddPose(GetWorld()->GetTimeSeconds(), InteractionSphereComp->GetComponentLocation(), InteractionSphereComp->GetComponentQuat());
+		}
+
+		// Nothing to grab and nothing was overlapping last frame, grab state and haptics can not change
+		if (GrabCandidates.Num() > 0 || PreviousOverlappedPhysicsActor)
+		{
+			UpdateInteractionWithOverlappingActors();
+		}
 
 		if (bLookForTeleportDestination)
 		{
 			UpdateTeleportDestination();
 		}
+
+		if (CurrentGrabedActor)
+		{
+			UpdateGrabbedActorTransform();
+		}
 	}
+
+	UpdateHapticFeedback();
 }
 
 
@@ -127,31 +252,37 @@ void ADVRMotionController::UpdateMotionControllerTransform()
 {
 	if (MeshComp)
 	{
-		MeshComp->SetRelativeLocation(RelativeHandPositionOffset, true);
+		// Offset is relative to MotionControllerComp and never changes. No sweep, MeshComp follows MotionControllerComp through attachment
+		MeshComp->SetRelativeLocation(RelativeHandPositionOffset);
 	}
 }
 
 
+void ADVRMotionController::OnHandComponentTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	++HandTransformUpdateCount;
+	INC_DWORD_STAT(STAT_HandComponentTransformUpdates);
+}
+
+
 void ADVRMotionController::UpdateUIInteractionSpline()
 {
-	if (UIInteractionSpline)
+	if (UIInteractionSpline && MotionControllerComp)
 	{
+		// Controller has not moved and nothing moved where the trace hit, spline from last frame is still correct
+		const FTransform ControllerPose = MotionControllerComp->GetComponentTransform();
+		if (CanReuseTraceCache(UIInteractionTraceCache, ControllerPose)) return;
+
 		UIInteractionSplineMesh->SetVisibility(false);
 
 		FVector InteractionTraceStart, InteractionTraceEnd;
-		GetUIInteractionTraceEnds(InteractionTraceStart, InteractionTraceEnd);
-
-		UIInteractionSpline->ClearSplinePoints(false);
-
-		// Add points to the spline. Points position is local to UIInteractionSpline. There are only two spline points, straight spline.
-		const FVector LocalStart = UIInteractionSpline->GetComponentTransform().InverseTransformPosition(InteractionTraceStart);
-		const FSplinePoint StartPoint(UIINTERACTION_START_INDEX, LocalStart, ESplinePointType::Linear);
-		UIInteractionSpline->AddPoint(StartPoint, false);
-
-		const FVector LocalEnd = UIInteractionSpline->GetComponentTransform().InverseTransformPosition(InteractionTraceEnd);
-		const FSplinePoint EndPoint(UIINTERACTION_END_INDEX, LocalEnd, ESplinePointType::Linear);
-		UIInteractionSpline->AddPoint(EndPoint, false);
+		FHitResult InteractionHit;
+		GetUIInteractionTraceEnds(InteractionTraceStart, InteractionTraceEnd, &InteractionHit);
+		UpdateTraceCache(UIInteractionTraceCache, ControllerPose, &InteractionHit);
 
+		// Move the two points of the straight spline in place, see InitUIInteractionSpline()
+		UIInteractionSpline->SetLocationAtSplinePoint(UIINTERACTION_START_INDEX, InteractionTraceStart, ESplineCoordinateSpace::World, false);
+		UIInteractionSpline->SetLocationAtSplinePoint(UIINTERACTION_END_INDEX, InteractionTraceEnd, ESplineCoordinateSpace::World, false);
 		UIInteractionSpline->UpdateSpline();
 
 		// Get new start and end position for the UIInteractionSpline
@@ -163,7 +294,68 @@ void ADVRMotionController::UpdateUIInteractionSpline()
 }
 
 
-void ADVRMotionController::GetUIInteractionTraceEnds(FVector& Start, FVector& End) const
+void ADVRMotionController::UpdateUIInteractionBeam()
+{
+	if (UIInteractionBeamMeshComp && WidgetInteractionComp && UIInteractionBeamMeshComp->GetStaticMesh())
+	{
+		// WidgetInteractionComp already traces every frame for widget hit testing, use its hit instead of tracing again.
+		// It only keeps widget hits, nothing blocks the trace in front of them
+		const FHitResult& WidgetInteractionHit = WidgetInteractionComp->GetLastHitResult();
+		float BeamLength = WidgetInteractionComp->InteractionDistance;
+		if (WidgetInteractionHit.bBlockingHit)
+		{
+			BeamLength = WidgetInteractionHit.Distance;
+		}
+		else
+		{
+			// No widget hit, stop the beam at walls and props instead of drawing it through them
+			const FVector Start = WidgetInteractionComp->GetComponentLocation();
+			const FVector End = Start + WidgetInteractionComp->GetForwardVector() * WidgetInteractionComp->InteractionDistance;
+
+			FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(UIInteractionBeam), false, this);
+			QueryParams.AddIgnoredActor(GetOwner());
+
+			FHitResult Hit;
+			if (GetWorld()->LineTraceSingleByChannel(Hit, Start, End, WidgetInteractionComp->TraceChannel, QueryParams))
+			{
+				BeamLength = Hit.Distance;
+			}
+		}
+
+		// Beam has not changed length, no need to update its transform
+		if (FMath::IsNearlyEqual(BeamLength, UIInteractionBeamLength)) return;
+
+		// Beam mesh is stretched along its X axis from WidgetInteractionComp location to the hit
+		const FBox MeshBounds = UIInteractionBeamMeshComp->GetStaticMesh()->GetBoundingBox();
+		const float MeshLength = FMath::Max(MeshBounds.Max.X - MeshBounds.Min.X, KINDA_SMALL_NUMBER);
+		const float LengthScale = BeamLength / MeshLength;
+
+		const FTransform BeamTransform(FQuat::Identity, FVector(-MeshBounds.Min.X * LengthScale, 0.f, 0.f), FVector(LengthScale, 1.f, 1.f));
+		UIInteractionBeamMeshComp->SetRelativeTransform(BeamTransform);
+		UIInteractionBeamLength = BeamLength;
+	}
+}
+
+
+void ADVRMotionController::InitUIInteractionSpline()
+{
+	if (UIInteractionSpline)
+	{
+		// UIInteractionSpline is a straight line with only two points. Points are moved every update, never added or removed
+		UIInteractionSpline->ClearSplinePoints(false);
+
+		const FSplinePoint StartPoint(UIINTERACTION_START_INDEX, FVector::ZeroVector, ESplinePointType::Linear);
+		UIInteractionSpline->AddPoint(StartPoint, false);
+
+		const FSplinePoint EndPoint(UIINTERACTION_END_INDEX, FVector::ForwardVector, ESplinePointType::Linear);
+		UIInteractionSpline->AddPoint(EndPoint, false);
+
+		UIInteractionSpline->UpdateSpline();
+	}
+}
+
+
+void ADVRMotionController::GetUIInteractionTraceEnds(FVector& Start, FVector& End, FHitResult* OutHit) const
 {
 	if (WidgetInteractionComp)
 	{
@@ -171,7 +363,13 @@ void ADVRMotionController::GetUIInteractionTraceEnds(FVector& Start, FVector& En
 		const FVector MaxEnd = Start + WidgetInteractionComp->GetForwardVector() * WidgetInteractionComp->InteractionDistance;
 
 		FHitResult Hit;
-		if (GetWorld()->LineTraceSingleByChannel(Hit, Start, MaxEnd, ECollisionChannel::ECC_Visibility))
+		const bool bHit = GetWorld()->LineTraceSingleByChannel(Hit, Start, MaxEnd, ECollisionChannel::ECC_Visibility);
+		if (OutHit)
+		{
+			*OutHit = Hit;
+		}
+
+		if (bHit)
 		{
 			End = Hit.Location;
 			return;
@@ -189,7 +387,7 @@ void ADVRMotionController::UpdateInteractionWithOverlappingActors()
 	if (CurrentOverlappedPhysicsActor && CurrentOverlappedPhysicsActor != PreviousOverlappedPhysicsActor &&
 		(!OtherHandMotionController || (OtherHandMotionController && OtherHandMotionController->GetCurrentGrabbedActor() != CurrentOverlappedPhysicsActor)))
 	{
-		PlayHapticEffect(CanPickupHapticEffect);
+		QueueHapticEffect(CanPickupHapticEffect);
 	}
 
 	const bool bIsOverlappingGrabableActor = CurrentOverlappedPhysicsActor != nullptr;
@@ -206,15 +404,12 @@ AActor* ADVRMotionController::GetNearestOverlappingPhysicsActor() const
 	{
 		const FVector InteractionSphereLocation = InteractionSphereComp->GetComponentLocation();
 		float NearestActorDistance = MAX_FLT;
-		TSet<AActor*> OverlappingActors;
-
-		InteractionSphereComp->GetOverlappingActors(OverlappingActors);
 
 		// There may be more than one actor overlapping InteractionSphereComp. Get the actor whose root component location is the closes
-		// to InteractionSphereComp's location
-		for (const auto& Actor : OverlappingActors)
+		// to InteractionSphereComp's location. GrabCandidates is kept up to date from InteractionSphereComp overlap events
+		for (AActor* Actor : GrabCandidates)
 		{
-			if (Actor->GetRootComponent()->IsSimulatingPhysics())
+			if (Actor && Actor->GetRootComponent() && Actor->GetRootComponent()->IsSimulatingPhysics())
 			{
 				float DistanceToActor = FVector::DistSquared(Actor->GetActorLocation(), InteractionSphereLocation);
 				if (DistanceToActor < NearestActorDistance)
@@ -230,15 +425,84 @@ AActor* ADVRMotionController::GetNearestOverlappingPhysicsActor() const
 }
 
 
-void ADVRMotionController::PlayHapticEffect(UHapticFeedbackEffect_Base* HapticEffect, float Intensity) const
+void ADVRMotionController::OnInteractionSphereCompBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	if (IsGrabCandidate(OtherActor))
+	{
+		GrabCandidates.AddUnique(OtherActor);
+	}
+}
+
+
+bool ADVRMotionController::IsGrabCandidate(const AActor* Actor) const
+{
+	// Walls, floors, the player and other hand overlap InteractionSphereComp too, keep them out of the per tick search
+	return Actor && Actor != this && Actor->IsA<ADInteractableActor>() && Cast<UPrimitiveComponent>(Actor->GetRootComponent());
+}
+
+
+void ADVRMotionController::OnInteractionSphereCompEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+{
+	// Actor may still be overlapping InteractionSphereComp with another of its components
+	if (OtherActor && InteractionSphereComp && !InteractionSphereComp->IsOverlappingActor(OtherActor))
+	{
+		GrabCandidates.RemoveSwap(OtherActor);
+	}
+}
+
+
+void ADVRMotionController::QueueHapticEffect(UHapticFeedbackEffect_Base* HapticEffect, float Intensity, int32 Priority)
+{
+	if (!HapticEffect) return;
+
+	INC_DWORD_STAT(STAT_HapticEffectsQueued);
+
+	// Keep the most important request, later requests with equal priority and intensity replace earlier ones
+	if (!QueuedHapticEffect.HapticEffect || Priority > QueuedHapticEffect.Priority ||
+		(Priority == QueuedHapticEffect.Priority && Intensity >= QueuedHapticEffect.Intensity))
+	{
+		QueuedHapticEffect.HapticEffect = HapticEffect;
+		QueuedHapticEffect.Intensity = FMath::Clamp(Intensity, 0.f, 1.f);
+		QueuedHapticEffect.Priority = Priority;
+	}
+}
+
+
+void ADVRMotionController::UpdateHapticFeedback()
 {
-	if (HapticEffect && OwnerVRPlayerCharacter)
+	if (!QueuedHapticEffect.HapticEffect) return;
+
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+	const bool bIsPlaying = CurrentTime < PlayingHapticEffectEndTime;
+	const bool bHigherPriority = QueuedHapticEffect.Priority > PlayingHapticEffect.Priority;
+
+	if (!bHigherPriority)
+	{
+		// Restarting the effect that is playing is not noticeable, drop request
+		if (bIsPlaying && QueuedHapticEffect.HapticEffect == PlayingHapticEffect.HapticEffect)
+		{
+			QueuedHapticEffect = FQueuedHapticEffect();
+			return;
+		}
+
+		// Keep request queued until min interval has passed
+		if (CurrentTime - PlayingHapticEffectStartTime < HapticMinInterval) return;
+	}
+
+	if (OwnerVRPlayerCharacter)
 	{
 		if (APlayerController* MyController = Cast<APlayerController>(OwnerVRPlayerCharacter->GetController()))
 		{
-			MyController->PlayHapticEffect(HapticEffect, MotionControllerComp->GetTrackingSource());//, Intensity);
+			MyController->PlayHapticEffect(QueuedHapticEffect.HapticEffect, MotionControllerComp->GetTrackingSource(), QueuedHapticEffect.Intensity);
+			INC_DWORD_STAT(STAT_HapticEffectsPlayed);
+
+			PlayingHapticEffect = QueuedHapticEffect;
+			PlayingHapticEffectStartTime = CurrentTime;
+			PlayingHapticEffectEndTime = CurrentTime + QueuedHapticEffect.HapticEffect->GetDuration();
 		}
 	}
+
+	QueuedHapticEffect = FQueuedHapticEffect();
 }
 
 
@@ -266,6 +530,9 @@ bool ADVRMotionController::TryAttachOverlappedActorToPhysicsHandle()
 		{
 			PhysicsConstraintComp->SetConstrainedComponents(InteractionSphereComp, NAME_None, OverlappingPhysicsActorRoot, NAME_None);
 			CurrentGrabedActor = PreviousOverlappedPhysicsActor;
+
+			// Where grabbed actor is held in the hand, used to measure lag and for bLateUpdateGrabbedActor
+			GrabbedActorRelativeTransform = OverlappingPhysicsActorRoot->GetComponentTransform().GetRelativeTransform(InteractionSphereComp->GetComponentTransform());
 		}
 	}
 
@@ -273,6 +540,46 @@ bool ADVRMotionController::TryAttachOverlappedActorToPhysicsHandle()
 }
 
 
+void ADVRMotionController::UpdateGrabbedActorTransform()
+{
+	UPrimitiveComponent* GrabbedActorRoot = CurrentGrabedActor ? Cast<UPrimitiveComponent>(CurrentGrabedActor->GetRootComponent()) : nullptr;
+	if (!GrabbedActorRoot || !InteractionSphereComp) return;
+
+	// Where the grabbed actor should be with this frame's controller pose
+	const FTransform HeldTransform = GrabbedActorRelativeTransform * InteractionSphereComp->GetComponentTransform();
+
+	if (bLateUpdateGrabbedActor)
+	{
+		// Sweep body to the hand without a teleport, velocity is kept. Stops at walls instead of moving the body through them
+		FHitResult Hit;
+		GrabbedActorRoot->SetWorldTransform(HeldTransform, true, &Hit, ETeleportType::None);
+	}
+
+	// Without late update how far the physics constraint trails the hand, with it how far blocking geometry holds the actor back
+	GrabbedActorLag = FVector::Dist(GrabbedActorRoot->GetComponentLocation(), HeldTransform.GetLocation());
+	INC_FLOAT_STAT_BY(STAT_GrabbedActorLag, GrabbedActorLag);
+}
+
+
+void ADVRMotionController::ApplyReleaseVelocity(AActor* ReleasedActor) const
+{
+	UPrimitiveComponent* ReleasedActorRoot = ReleasedActor ? Cast<UPrimitiveComponent>(ReleasedActor->GetRootComponent()) : nullptr;
+	if (!ReleasedActorRoot || !ReleasedActorRoot->IsSimulatingPhysics() || !InteractionSphereComp) return;
+
+	// Released because other hand grabbed it, other hand controls velocity now
+	if (OtherHandMotionController && OtherHandMotionController->GetCurrentGrabbedActor() == ReleasedActor) return;
+
+	FVector HandLinearVelocity;
+	FVector HandAngularVelocity;
+	if (!PoseHistory.EstimateVelocity(ReleaseVelocityWindow, HandLinearVelocity, HandAngularVelocity)) return;
+
+	// Released actor is rigidly held by the hand, so its center moves with the hand's linear velocity plus the hand's rotation around it
+	const FVector HandToActor = ReleasedActorRoot->GetComponentLocation() - InteractionSphereComp->GetComponentLocation();
+	ReleasedActorRoot->SetPhysicsLinearVelocity(HandLinearVelocity + (HandAngularVelocity ^ HandToActor));
+	ReleasedActorRoot->SetPhysicsAngularVelocityInRadians(HandAngularVelocity);
+}
+
+
 void ADVRMotionController::AlertGrabbedActorOfGrabState(EGrabState State) const
 {
 	// If grabbed actor was of type ADInteractableActor alert Actor is was grabbed
@@ -295,17 +602,48 @@ void ADVRMotionController::AlertGrabbedActorOfGrabState(EGrabState State) const
 /*******************************************************************/
 void ADVRMotionController::UpdateTeleportDestination()
 {
-	if (TeleportDestinationMarker)
+	SCOPE_CYCLE_COUNTER(STAT_UpdateTeleportDestination);
+
+	if (TeleportDestinationMarker && MotionControllerComp)
 	{
-		TArray<FVector> Path;
-		bHasValidTeleportDestination = FindTeleportDestination(Path, TeleportDestination);
+		// Controller has not moved and nothing moved where the projectile path hit, path and marker from last frame are still correct
+		if (CanReuseTraceCache(TeleportPathTraceCache, MotionControllerComp->GetComponentTransform()))
+		{
+			// Sweeps in flight were issued before the reused results, collecting them on a later miss would show a stale path
+			TeleportTraceHandles.Reset();
+			return;
+		}
+
+		// Path buffer is reused every frame to avoid reallocating
+		TArray<FVector>& Path = TeleportPathBuffer;
+		Path.Reset();
+
+		if (TeleportTraceMode == ETeleportTraceMode::ETTM_Async)
+		{
+			bool bHasResult = false;
+			const bool bValidDestination = CollectAsyncTeleportDestination(Path, TeleportDestination, bHasResult);
+			RequestAsyncTeleportDestination();
+
+			// No results from last frame yet (first frame looking for teleport destination), keep current marker and path
+			if (!bHasResult) return;
+
+			bHasValidTeleportDestination = bValidDestination;
+		}
+		else if (TeleportTraceMode == ETeleportTraceMode::ETTM_Broadphase)
+		{
+			bHasValidTeleportDestination = FindTeleportDestinationBroadphase(Path, TeleportDestination);
+		}
+		else
+		{
+			bHasValidTeleportDestination = FindTeleportDestination(Path, TeleportDestination);
+		}
 
 		// draw and show teleport destination and path
 		if (bHasValidTeleportDestination)
 		{
 			TeleportDestinationMarker->SetWorldLocationAndRotation(TeleportDestination, FRotator(0.f));
 			ShowTeleportDestination(true);
-			SetTeleportSplineMeshComponents(Path);
+			UpdateTeleportArcMesh(Path);
 		}
 		else // hide teleport destination marker, clear projectile path
 		{
@@ -323,22 +661,31 @@ bool ADVRMotionController::FindTeleportDestination(TArray<FVector>& OutPath, FVe
 		const FVector Start = MotionControllerComp->GetComponentLocation();
 		const FVector LaunchVelocity = MotionControllerComp->GetForwardVector() * TeleportProjectileSpeed;
 
-		TArray<AActor*> IgnoreActors;
-		SetIgnoreActorsForTeleportDestination(IgnoreActors);
-
-		FPredictProjectilePathParams PredictProjectilePathParams(
-			TeleportProjectileRadius,
-			Start,
-			LaunchVelocity,
-			TeleportSimulationTime,
-			ECollisionChannel::ECC_Visibility
-		);
-
+		SetIgnoreActorsForTeleportDestination(TeleportIgnoreActors);
+
+		// Params and result are members so their arrays keep their allocations between frames
+		FPredictProjectilePathParams& PredictProjectilePathParams = TeleportPredictPathParams;
+		PredictProjectilePathParams.ProjectileRadius = TeleportProjectileRadius;
+		PredictProjectilePathParams.StartLocation = Start;
+		PredictProjectilePathParams.LaunchVelocity = LaunchVelocity;
+		PredictProjectilePathParams.MaxSimTime = TeleportSimulationTime;
+		PredictProjectilePathParams.bTraceWithCollision = true;
+		PredictProjectilePathParams.bTraceWithChannel = true;
+		PredictProjectilePathParams.TraceChannel = ECollisionChannel::ECC_Visibility;
 		PredictProjectilePathParams.bTraceComplex = bTeleportTraceComplex;
-		PredictProjectilePathParams.ActorsToIgnore = IgnoreActors;
-		FPredictProjectilePathResult Result;
+		PredictProjectilePathParams.ActorsToIgnore.Reset();
+		PredictProjectilePathParams.ActorsToIgnore.Append(TeleportIgnoreActors);
+		PredictProjectilePathParams.SimFrequency = TeleportSimulationFrequency;
+		FPredictProjectilePathResult& Result = TeleportPredictPathResult;
 
 		bool bHit = UGameplayStatics::PredictProjectilePath(this, PredictProjectilePathParams, Result);
+		UpdateTraceCache(TeleportPathTraceCache, MotionControllerComp->GetComponentTransform(), bHit ? &Result.HitResult : nullptr);
+
+		// PredictProjectilePath sweeps once for every path segment until the first hit
+		const int32 QueryCount = FMath::Max(0, Result.PathData.Num() - 1);
+		TeleportTraceQueryCount += QueryCount;
+		INC_DWORD_STAT_BY(STAT_TeleportPathSceneQueries, QueryCount);
+
 		if (!bHit) return false;
 
 		// Store positions of projectile path for OutPath param
@@ -347,22 +694,247 @@ bool ADVRMotionController::FindTeleportDestination(TArray<FVector>& OutPath, FVe
 			OutPath.Add(PointData.Location);
 		}
 
-		// Get point on navmesh where PredictProjectilePath hit for OutLocation param
-		FNavLocation NavLocation;
-		bool bOnNavMesh = UNavigationSystemV1::GetCurrent(GetWorld())->ProjectPointToNavigation(Result.HitResult.Location, NavLocation);
-		if (!bOnNavMesh) return false;
+		return ProjectTeleportLocationToNavigation(Result.HitResult.Location, OutLocation);
+	}
+
+	return false;
+}
 
-		OutLocation = NavLocation.Location;
 
-		return true;
+bool ADVRMotionController::FindTeleportDestinationBroadphase(TArray<FVector>& OutPath, FVector& OutLocation)
+{
+	if (MotionControllerComp)
+	{
+		const FVector Start = MotionControllerComp->GetComponentLocation();
+		const FVector LaunchVelocity = MotionControllerComp->GetForwardVector() * TeleportProjectileSpeed;
+
+		TArray<FVector>& Points = TeleportBroadphasePathPoints;
+		GetTeleportProjectilePathPoints(Start, LaunchVelocity, Points);
+
+		SetIgnoreActorsForTeleportDestination(TeleportIgnoreActors);
+
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(TeleportProjectilePath), bTeleportTraceComplex);
+		QueryParams.AddIgnoredActors(TeleportIgnoreActors);
+
+		FHitResult Hit;
+		int32 HitSegment = INDEX_NONE;
+		const bool bHit = SweepTeleportPathSegments(Points, 0, Points.Num() - 1, QueryParams, Hit, HitSegment);
+		UpdateTraceCache(TeleportPathTraceCache, MotionControllerComp->GetComponentTransform(), bHit ? &Hit : nullptr);
+		if (!bHit) return false;
+
+		// Store positions of projectile path up to the hit for OutPath param
+		for (int32 i = 0; i <= HitSegment; ++i)
+		{
+			OutPath.Add(Points[i]);
+		}
+		OutPath.Add(Hit.Location);
+
+		return ProjectTeleportLocationToNavigation(Hit.Location, OutLocation);
 	}
 
 	return false;
 }
 
 
+bool ADVRMotionController::SweepTeleportPathSegments(const TArray<FVector>& Points, int32 FirstPoint, int32 LastPoint, const FCollisionQueryParams& QueryParams, FHitResult& OutHit, int32& OutHitSegment)
+{
+	if (LastPoint <= FirstPoint) return false;
+
+	UWorld* World = GetWorld();
+
+	++TeleportTraceQueryCount;
+	INC_DWORD_STAT(STAT_TeleportPathSceneQueries);
+
+	// Single segment left, sweep it for the hit location
+	if (LastPoint - FirstPoint == 1)
+	{
+		const bool bHit = World->SweepSingleByChannel(
+			OutHit,
+			Points[FirstPoint],
+			Points[LastPoint],
+			FQuat::Identity,
+			ECollisionChannel::ECC_Visibility,
+			FCollisionShape::MakeSphere(TeleportProjectileRadius),
+			QueryParams
+		);
+
+		if (bHit)
+		{
+			OutHitSegment = FirstPoint;
+		}
+
+		return bHit;
+	}
+
+	// Sphere swept along straight segments between points never leaves the points bounding box expanded by the sphere radius
+	FBox SegmentsBounds(ForceInit);
+	for (int32 i = FirstPoint; i <= LastPoint; ++i)
+	{
+		SegmentsBounds += Points[i];
+	}
+	SegmentsBounds = SegmentsBounds.ExpandBy(TeleportProjectileRadius);
+
+	const bool bOverlap = World->OverlapBlockingTestByChannel(
+		SegmentsBounds.GetCenter(),
+		FQuat::Identity,
+		ECollisionChannel::ECC_Visibility,
+		FCollisionShape::MakeBox(SegmentsBounds.GetExtent()),
+		QueryParams
+	);
+
+	if (!bOverlap) return false;
+
+	// Something is inside the bounds, check first half of path segments first so the earliest hit along path is found
+	const int32 MidPoint = (FirstPoint + LastPoint) / 2;
+	if (SweepTeleportPathSegments(Points, FirstPoint, MidPoint, QueryParams, OutHit, OutHitSegment))
+	{
+		return true;
+	}
+
+	return SweepTeleportPathSegments(Points, MidPoint, LastPoint, QueryParams, OutHit, OutHitSegment);
+}
+
+
+bool ADVRMotionController::CollectAsyncTeleportDestination(TArray<FVector>& OutPath, FVector& OutLocation, bool& bOutHasResult)
+{
+	bOutHasResult = false;
+
+	const int32 SegmentCount = TeleportTraceHandles.Num();
+	if (SegmentCount == 0) return false;
+
+	// Async trace delegates are only run for one frame. If any results are missing treat as no result
+	if (TeleportTraceCompletedCount != SegmentCount)
+	{
+		TeleportTraceHandles.Reset();
+		return false;
+	}
+
+	bool bHit = false;
+	int32 HitSegment = INDEX_NONE;
+
+	// Walk path segments in order, the first blocking hit ends the projectile path
+	OutPath.Add(TeleportTracePathPoints[0]);
+	for (int32 i = 0; i < SegmentCount; ++i)
+	{
+		if (TeleportTraceSegmentHits[i].bBlockingHit)
+		{
+			bHit = true;
+			HitSegment = i;
+			OutPath.Add(TeleportTraceSegmentHits[i].Location);
+			break;
+		}
+
+		OutPath.Add(TeleportTracePathPoints[i + 1]);
+	}
+
+	TeleportTraceHandles.Reset();
+	bOutHasResult = true;
+
+	// Results are for the pose sweeps were issued from, not the current pose
+	UpdateTraceCache(TeleportPathTraceCache, TeleportTracePose, bHit ? &TeleportTraceSegmentHits[HitSegment] : nullptr);
+	if (!bHit) return false;
+
+	return ProjectTeleportLocationToNavigation(TeleportTraceSegmentHits[HitSegment].Location, OutLocation);
+}
+
+
+void ADVRMotionController::RequestAsyncTeleportDestination()
+{
+	UWorld* World = GetWorld();
+	if (!World || !MotionControllerComp) return;
+
+	TeleportTracePose = MotionControllerComp->GetComponentTransform();
+	const FVector Start = TeleportTracePose.GetLocation();
+	const FVector LaunchVelocity = MotionControllerComp->GetForwardVector() * TeleportProjectileSpeed;
+	GetTeleportProjectilePathPoints(Start, LaunchVelocity, TeleportTracePathPoints);
+
+	SetIgnoreActorsForTeleportDestination(TeleportIgnoreActors);
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(TeleportProjectilePath), bTeleportTraceComplex);
+	QueryParams.AddIgnoredActors(TeleportIgnoreActors);
+	const FCollisionShape SweepShape = FCollisionShape::MakeSphere(TeleportProjectileRadius);
+
+	const int32 SegmentCount = TeleportTracePathPoints.Num() - 1;
+	TeleportTraceSegmentHits.SetNum(SegmentCount, false);
+	TeleportTraceCompletedCount = 0;
+
+	// One sweep for each path segment. Every segment is swept, collecting results will stop at the first blocking hit.
+	// Segment index is passed as trace user data, see OnTeleportTraceSegmentCompleted()
+	TeleportTraceHandles.Reset();
+	for (int32 i = 0; i < SegmentCount; ++i)
+	{
+		INC_DWORD_STAT(STAT_TeleportPathSceneQueries);
+		TeleportTraceHandles.Add(World->AsyncSweepByChannel(
+			EAsyncTraceType::Single,
+			TeleportTracePathPoints[i],
+			TeleportTracePathPoints[i + 1],
+			FQuat::Identity,
+			ECollisionChannel::ECC_Visibility,
+			SweepShape,
+			QueryParams,
+			FCollisionResponseParams::DefaultResponseParam,
+			&TeleportTraceDelegate,
+			static_cast<uint32>(i)
+		));
+	}
+}
+
+
+void ADVRMotionController::OnTeleportTraceSegmentCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	// Ignore results for sweeps that are no longer pending
+	const int32 Segment = static_cast<int32>(TraceDatum.UserData);
+	if (!TeleportTraceHandles.IsValidIndex(Segment) || TeleportTraceHandles[Segment] != TraceHandle) return;
+
+	// Results are read in place, TraceDatum.OutHits is not copied
+	const FHitResult* BlockingHit = TraceDatum.OutHits.FindByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
+	if (BlockingHit)
+	{
+		TeleportTraceSegmentHits[Segment] = *BlockingHit;
+	}
+	else
+	{
+		TeleportTraceSegmentHits[Segment].bBlockingHit = false;
+	}
+
+	++TeleportTraceCompletedCount;
+}
+
+
+void ADVRMotionController::GetTeleportProjectilePathPoints(const FVector& Start, const FVector& LaunchVelocity, TArray<FVector>& OutPoints) const
+{
+	const float GravityZ = GetWorld()->GetGravityZ();
+	const int32 SegmentCount = FMath::Max(1, FMath::CeilToInt(TeleportSimulationTime * TeleportSimulationFrequency));
+	const float SubstepTime = TeleportSimulationTime / SegmentCount;
+
+	OutPoints.Reset(SegmentCount + 1);
+	for (int32 i = 0; i <= SegmentCount; ++i)
+	{
+		const float Time = i * SubstepTime;
+		OutPoints.Add(Start + LaunchVelocity * Time + FVector(0.f, 0.f, 0.5f * GravityZ * Time * Time));
+	}
+}
+
+
+bool ADVRMotionController::ProjectTeleportLocationToNavigation(const FVector& HitLocation, FVector& OutLocation) const
+{
+	UNavigationSystemV1* NavigationSystem = UNavigationSystemV1::GetCurrent(GetWorld());
+	if (!NavigationSystem) return false;
+
+	// Get point on navmesh where projectile path hit
+	FNavLocation NavLocation;
+	bool bOnNavMesh = NavigationSystem->ProjectPointToNavigation(HitLocation, NavLocation);
+	if (!bOnNavMesh) return false;
+
+	OutLocation = NavLocation.Location;
+
+	return true;
+}
+
+
 void ADVRMotionController::SetIgnoreActorsForTeleportDestination(TArray<AActor*>& OutIgnoreActors)
 {
+	OutIgnoreActors.Reset();
 	OutIgnoreActors.Add(this);
 	if (CurrentGrabedActor)
 	{
@@ -375,68 +947,79 @@ void ADVRMotionController::SetIgnoreActorsForTeleportDestination(TArray<AActor*>
 }
 
 
-void ADVRMotionController::SetTeleportSplineMeshComponents(const TArray<FVector>& Path)
+void ADVRMotionController::InitTeleportArcMesh()
 {
-	if (TeleportSplinePath && TeleportArchMesh && TeleportArchMaterial)
+	if (TeleportArcMeshComp && TeleportArchMesh && TeleportArchMaterial)
 	{
-		// Add all points from teleport projectile path to TeleportSplinePath
-		UpdateTeleportSpline(Path);
+		TeleportArcMeshComp->SetStaticMesh(TeleportArchMesh);
+		TeleportArcMeshComp->SetMaterial(0, TeleportArchMaterial);
 
-		// Hide all SplineMeshComponents in object pool
-		for (auto& SplineMesh : TeleportMeshObjectPool)
+		const UMaterial* BaseMaterial = TeleportArchMaterial->GetMaterial();
+		if (BaseMaterial && !BaseMaterial->bUsedWithInstancedStaticMeshes)
 		{
-			SplineMesh->SetVisibility(false);
+			UE_LOG(LogDungeonEscapeVR, Warning, TEXT("%s: TeleportArchMaterial %s is not used with instanced static meshes, teleport arc draws with the default material"),
+				*GetName(), *BaseMaterial->GetName());
 		}
 
-		const int32 SegmentNumber = Path.Num() - 1;
-		for (int32 i = 0; i < SegmentNumber; ++i)
+		// Hidden segments are collapsed to zero scale
+		TeleportArcInstanceTransforms.Init(FTransform(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector), MaxTeleportArcSegments);
+		TeleportArcMeshComp->ClearInstances();
+		for (const FTransform& InstanceTransform : TeleportArcInstanceTransforms)
 		{
-			// create a new SplineMeshComponent if there are not enough in TeleportMeshObjectPool
-			if (TeleportMeshObjectPool.Num() <= i)
-			{
-				USplineMeshComponent* SplineMeshComponent = NewObject<USplineMeshComponent>(this);
-				if (SplineMeshComponent)
-				{
-					SplineMeshComponent->SetMobility(EComponentMobility::Movable);
-					SplineMeshComponent->AttachToComponent(TeleportSplinePath, FAttachmentTransformRules::KeepRelativeTransform);
-					SplineMeshComponent->SetStaticMesh(TeleportArchMesh);
-					SplineMeshComponent->SetMaterial(0, TeleportArchMaterial);
-					SplineMeshComponent->RegisterComponent();
-
-					TeleportMeshObjectPool.Add(SplineMeshComponent);
-				}
-			}
-
-			// Add Mesh from TeleportMeshObjectPool to position on TeleportSplinePath
-			if (TeleportMeshObjectPool[i])
-			{
-				FVector StartPos, StartTangent, EndPos, EndTangent;
-				TeleportSplinePath->GetLocalLocationAndTangentAtSplinePoint(i, StartPos, StartTangent);
-				TeleportSplinePath->GetLocalLocationAndTangentAtSplinePoint(i + 1, EndPos, EndTangent);
-				TeleportMeshObjectPool[i]->SetStartAndEnd(StartPos, StartTangent, EndPos, EndTangent);
-
-				TeleportMeshObjectPool[i]->SetVisibility(true, true);
-			}
+			TeleportArcMeshComp->AddInstance(InstanceTransform);
 		}
 	}
 }
 
 
-void ADVRMotionController::UpdateTeleportSpline(const TArray<FVector>& Path)
+void ADVRMotionController::UpdateTeleportArcMesh(const TArray<FVector>& Path)
 {
-	if (TeleportSplinePath)
+	if (TeleportArcMeshComp && TeleportArchMesh && TeleportArcInstanceTransforms.Num() > 0)
 	{
-		TeleportSplinePath->ClearSplinePoints(false);
+		// Paths longer than the instance count are drawn whole, each instance spanning PointStride path points
+		const int32 PathSegmentNumber = Path.Num() - 1;
+		const int32 PointStride = PathSegmentNumber > 0 ? FMath::DivideAndRoundUp(PathSegmentNumber, TeleportArcInstanceTransforms.Num()) : 1;
+		const int32 SegmentNumber = PathSegmentNumber > 0 ? FMath::DivideAndRoundUp(PathSegmentNumber, PointStride) : 0;
+
+		// Nothing to draw and already hidden, no need to touch render state
+		if (SegmentNumber <= 0 && !bTeleportArcVisible) return;
 
-		// Add points from the teleport projectile prediction path to TeleportSplinePath
-		for (int32 i = 0; i < Path.Num(); ++i)
+		// TeleportArchMesh is stretched along its X axis to span each segment
+		const FBox MeshBounds = TeleportArchMesh->GetBoundingBox();
+		const float MeshLength = FMath::Max(MeshBounds.Max.X - MeshBounds.Min.X, KINDA_SMALL_NUMBER);
+
+		for (int32 i = 0; i < TeleportArcInstanceTransforms.Num(); ++i)
 		{
-			const FVector LocalPosition = TeleportSplinePath->GetComponentTransform().InverseTransformPosition(Path[i]);
-			const FSplinePoint Point(i, LocalPosition, ESplinePointType::Curve);
-			TeleportSplinePath->AddPoint(Point, false);
+			FTransform& InstanceTransform = TeleportArcInstanceTransforms[i];
+			if (i < SegmentNumber)
+			{
+				const FVector& SegmentStart = Path[i * PointStride];
+				const FVector Segment = Path[FMath::Min((i + 1) * PointStride, PathSegmentNumber)] - SegmentStart;
+				const float SegmentLength = Segment.Size();
+				const FVector Direction = SegmentLength > KINDA_SMALL_NUMBER ? Segment / SegmentLength : FVector::ForwardVector;
+				const float LengthScale = SegmentLength / MeshLength;
+
+				InstanceTransform.SetRotation(FRotationMatrix::MakeFromX(Direction).ToQuat());
+				InstanceTransform.SetScale3D(FVector(LengthScale, 1.f, 1.f));
+				InstanceTransform.SetLocation(SegmentStart - Direction * MeshBounds.Min.X * LengthScale);
+			}
+			else
+			{
+				InstanceTransform.SetScale3D(FVector::ZeroVector);
+			}
 		}
 
-		TeleportSplinePath->UpdateSpline();
+		// All segments are sent to the render thread in one update
+		TeleportArcMeshComp->BatchUpdateInstancesTransforms(0, TeleportArcInstanceTransforms, true, true, true);
+		INC_DWORD_STAT(STAT_TeleportArcMeshComponentUpdates);
+
+		const bool bShowArc = SegmentNumber > 0;
+		if (bShowArc != bTeleportArcVisible)
+		{
+			TeleportArcMeshComp->SetVisibility(bShowArc);
+			bTeleportArcVisible = bShowArc;
+			INC_DWORD_STAT(STAT_TeleportArcMeshComponentUpdates);
+		}
 	}
 }
 
@@ -444,7 +1027,7 @@ void ADVRMotionController::UpdateTeleportSpline(const TArray<FVector>& Path)
 void ADVRMotionController::ClearTeleportPath()
 {
 	TArray<FVector> EmptyPath;
-	SetTeleportSplineMeshComponents(EmptyPath);
+	UpdateTeleportArcMesh(EmptyPath);
 }
 
 
@@ -466,6 +1049,9 @@ void ADVRMotionController::StartFindTeleportDestination()
 void ADVRMotionController::StopFindTeleportDestination()
 {
 	bLookForTeleportDestination = false;
+	bHasValidTeleportDestination = false;
+	TeleportTraceHandles.Reset();
+	TeleportPathTraceCache.bValid = false;
 	ClearTeleportPath();
 	ShowTeleportDestination(false);
 }
@@ -482,6 +1068,112 @@ bool ADVRMotionController::GetCurrentTeleportDestinationMarketLocation(FVector&
 }
 
 
+/*******************************************************************/
+/* Pose Gating */
+/*******************************************************************/
+bool ADVRMotionController::CanReuseTraceCache(const FPoseGatedTraceCache& Cache, const FTransform& Pose)
+{
+	if (!bEnablePoseGating) return false;
+
+	bool bReuse = Cache.bValid;
+
+	// Controller must be within tolerance of the pose the cached trace was run from
+	if (bReuse)
+	{
+		const bool bLocationWithinTolerance = FVector::DistSquared(Pose.GetLocation(), Cache.Pose.GetLocation()) <= FMath::Square(PoseGatingLocationTolerance);
+		const bool bRotationWithinTolerance = FMath::RadiansToDegrees(Pose.GetRotation().AngularDistance(Cache.Pose.GetRotation())) <= PoseGatingRotationTolerance;
+		bReuse = bLocationWithinTolerance && bRotationWithinTolerance;
+	}
+
+	// Changes along the trace away from the hit are not checked, retrace regularly to pick them up
+	if (bReuse)
+	{
+		bReuse = GetWorld()->GetTimeSeconds() - Cache.TraceTime <= PoseGatingMaxReuseTime;
+	}
+
+	// Grabbed actors are ignored by teleport traces, grabbing or releasing changes what can be hit
+	if (bReuse)
+	{
+		AActor* OtherHandGrabbedActor = OtherHandMotionController ? OtherHandMotionController->GetCurrentGrabbedActor() : nullptr;
+		bReuse = Cache.GrabbedActor.Get() == CurrentGrabedActor && Cache.OtherHandGrabbedActor.Get() == OtherHandGrabbedActor;
+	}
+
+	// World near cached hit must not have changed, the component hit can not have moved or been destroyed
+	UPrimitiveComponent* HitComponent = bReuse ? Cache.HitComponent.Get() : nullptr;
+	if (bReuse)
+	{
+		bReuse = HitComponent && HitComponent->GetComponentTransform().Equals(Cache.HitComponentTransform);
+	}
+
+	// Other parts of the actor hit have moved, e.g. a door leaf over its frame. Only then check they did not move over the hit
+	AActor* HitActor = bReuse ? HitComponent->GetOwner() : nullptr;
+	if (bReuse && HitActor && PoseGatingHitClearance > 0.f && !HitActor->GetActorTransform().Equals(Cache.HitActorTransform))
+	{
+		SetIgnoreActorsForTeleportDestination(TeleportIgnoreActors);
+
+		// Player's own hands, held actors and body can be inside the sphere when the hit is close
+		if (AActor* OwningPawn = GetOwner())
+		{
+			TeleportIgnoreActors.Add(OwningPawn);
+			OwningPawn->GetAttachedActors(TeleportIgnoreActors, false);
+		}
+		GetAttachedActors(TeleportIgnoreActors, false);
+
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(PoseGatingHitClearance), false);
+		QueryParams.AddIgnoredActors(TeleportIgnoreActors);
+		QueryParams.AddIgnoredComponent(HitComponent);
+
+		// Sphere rests just above the hit surface so the surface itself is not overlapped
+		const FVector ClearanceCenter = Cache.HitLocation + Cache.HitNormal * (PoseGatingHitClearance + 1.f);
+		bReuse = !GetWorld()->OverlapBlockingTestByChannel(ClearanceCenter, FQuat::Identity, ECollisionChannel::ECC_Visibility,
+			FCollisionShape::MakeSphere(PoseGatingHitClearance), QueryParams);
+	}
+
+	if (bReuse)
+	{
+		++PoseGatingHitCount;
+		INC_DWORD_STAT(STAT_PoseGatingHits);
+	}
+	else
+	{
+		++PoseGatingMissCount;
+		INC_DWORD_STAT(STAT_PoseGatingMisses);
+	}
+
+	return bReuse;
+}
+
+
+void ADVRMotionController::UpdateTraceCache(FPoseGatedTraceCache& Cache, const FTransform& Pose, const FHitResult* Hit) const
+{
+	UPrimitiveComponent* HitComponent = Hit && Hit->bBlockingHit ? Hit->GetComponent() : nullptr;
+
+	Cache.bValid = HitComponent != nullptr;
+	Cache.Pose = Pose;
+	Cache.HitComponent = HitComponent;
+	Cache.HitComponentTransform = HitComponent ? HitComponent->GetComponentTransform() : FTransform::Identity;
+	Cache.HitActorTransform = HitComponent && HitComponent->GetOwner() ? HitComponent->GetOwner()->GetActorTransform() : FTransform::Identity;
+	Cache.HitLocation = HitComponent ? Hit->ImpactPoint : FVector::ZeroVector;
+	Cache.HitNormal = HitComponent ? Hit->ImpactNormal : FVector::UpVector;
+	Cache.GrabbedActor = CurrentGrabedActor;
+	Cache.OtherHandGrabbedActor = OtherHandMotionController ? OtherHandMotionController->GetCurrentGrabbedActor() : nullptr;
+	Cache.TraceTime = GetWorld()->GetTimeSeconds();
+}
+
+
+void ADVRMotionController::OnNavigationGenerationFinished(ANavigationData* NavData)
+{
+	TeleportPathTraceCache.bValid = false;
+}
+
+
+float ADVRMotionController::GetPoseGatingHitRate() const
+{
+	const int32 TotalCount = PoseGatingHitCount + PoseGatingMissCount;
+	return TotalCount > 0 ? static_cast<float>(PoseGatingHitCount) / TotalCount : 0.f;
+}
+
+
 /*******************************************************************/
 /* Configuration */
 /*******************************************************************/
@@ -490,11 +1182,14 @@ void ADVRMotionController::SetHand(EControllerHand Hand)
 	// EControllerHand contains many values, only left and right are valid for this class
 	check(Hand == EControllerHand::Left || Hand == EControllerHand::Right);
 
-	if (MotionControllerComp)
+	if (MotionControllerComp && MeshComp)
 	{
 		ControllerHand = Hand;
 		MotionControllerComp->SetTrackingSource(ControllerHand);
 
+		// Scale, rotation and offset are applied to MeshComp together, child components are only updated once
+		FScopedMovementUpdate HandMeshUpdate(MeshComp, EScopedUpdate::DeferredUpdates);
+
 		if (ControllerHand == EControllerHand::Left)
 		{
 			MeshComp->SetWorldScale3D(FVector(HandScale, HandScale, -HandScale));
@@ -505,22 +1200,34 @@ void ADVRMotionController::SetHand(EControllerHand Hand)
 			MeshComp->SetWorldScale3D(FVector(HandScale));
 			MeshComp->SetRelativeRotation(FRotator(0.f, 0.f, 90.f));
 		}
+
+		UpdateMotionControllerTransform();
 	}
 }
 
 
 void ADVRMotionController::SetControllerMode(EControllerMode Mode)
 {
-	if (WidgetInteractionComp && UIInteractionSplineMesh && UIInteractionSpline && InteractionSphereComp && TeleportDestinationMarker && TeleportSplinePath)
+	if (WidgetInteractionComp && UIInteractionSplineMesh && UIInteractionSpline && InteractionSphereComp && TeleportDestinationMarker)
 	{
 		WidgetInteractionComp->SetActive(Mode == EControllerMode::ECM_UI);
-		UIInteractionSplineMesh->SetActive(Mode == EControllerMode::ECM_UI);
-		UIInteractionSplineMesh->SetVisibility(Mode == EControllerMode::ECM_UI, true);
-		UIInteractionSpline->SetActive(Mode == EControllerMode::ECM_UI);
+		// UI pointer is drawn with either UIInteractionSplineMesh or UIInteractionBeamMeshComp, see bUseWidgetInteractionHitForUIPointer
+		const bool bShowUIInteractionSpline = Mode == EControllerMode::ECM_UI && !bUseWidgetInteractionHitForUIPointer;
+		UIInteractionSplineMesh->SetActive(bShowUIInteractionSpline);
+		UIInteractionSplineMesh->SetVisibility(bShowUIInteractionSpline, true);
+		UIInteractionSpline->SetActive(bShowUIInteractionSpline);
+
+		if (UIInteractionBeamMeshComp)
+		{
+			UIInteractionBeamMeshComp->SetVisibility(Mode == EControllerMode::ECM_UI && bUseWidgetInteractionHitForUIPointer);
+		}
 
 		InteractionSphereComp->SetActive(Mode == EControllerMode::ECM_Game);
 		TeleportDestinationMarker->SetActive(Mode == EControllerMode::ECM_Game);
-		TeleportSplinePath->SetActive(Mode == EControllerMode::ECM_Game);
+
+		// Splines visibility changed, redraw next update
+		UIInteractionTraceCache.bValid = false;
+		TeleportPathTraceCache.bValid = false;
 
 		ControllerMode = Mode;
 	}
@@ -605,12 +1312,17 @@ void ADVRMotionController::Release()
 			AlertGrabbedActorOfGrabState(EGrabState::EGS_Release);
 		}
 
-		CurrentGrabedActor = nullptr;
-
 		if (PhysicsConstraintComp)
 		{
 			PhysicsConstraintComp->BreakConstraint();
 		}
+
+		if (CurrentGrabedActor && bApplyReleaseVelocity)
+		{
+			ApplyReleaseVelocity(CurrentGrabedActor);
+		}
+
+		CurrentGrabedActor = nullptr;
 	}
 }
 
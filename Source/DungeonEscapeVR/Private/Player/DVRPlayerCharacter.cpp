@@ -10,12 +10,25 @@
 #include "Kismet/GameplayStatics.h"
 #include "DrawDebugHelpers.h"
 #include "HeadMountedDisplayFunctionLibrary.h"
+#include "Misc/App.h"
+#include "RenderCore.h"
 
 // Game Includes
+#include "../DungeonEscapeVR.h"
+#include "Collision/DStaticDistanceFieldSubsystem.h"
+#include "Gameplay/DInteractableOutlineSubsystem.h"
+#include "Gameplay/DInteractableProximitySubsystem.h"
+#include "Player/DCameraFadeComponent.h"
+#include "Player/DTeleportBlackoutSubsystem.h"
 #include "Player./DVRMotionController.h"
 #include "Player/DVRPlayerController.h"
 
 
+DECLARE_CYCLE_STAT(TEXT("AlignRootToVRRoot"), STAT_AlignRootToVRRoot, STATGROUP_DungeonEscapeVR);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Character Component Transform Updates"), STAT_CharacterComponentTransformUpdates, STATGROUP_DungeonEscapeVR);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Relocation HMD Error (cm)"), STAT_RelocationHMDError, STATGROUP_DungeonEscapeVR);
+
+
 // Sets default values
 ADVRPlayerCharacter::ADVRPlayerCharacter()
 {
@@ -33,14 +46,38 @@ ADVRPlayerCharacter::ADVRPlayerCharacter()
 	CameraCollisionComp->SetSphereRadius(45.f);
 	CameraCollisionComp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 
+	CameraFadeComp = CreateDefaultSubobject<UDCameraFadeComponent>(TEXT("CameraFadeComp"));
+
 	DegreesOnTurn = 45.f;
-	CameraCollisionCheckRate = 0.2f;
+	RoomScaleAlignmentDeadZone = 1.f;
+	bPredictHMDLocationOnRelocation = true;
+	HMDPredictionVelocityWindow = 0.05f;
+	RelocationIntendedHMDLocation = FVector::ZeroVector;
+	bMeasureRelocationError = false;
+	RelocationLateUpdateTime = 0.0;
+	LastRelocationError = 0.f;
+	CameraCollisionCheckRate = 0.5f;
+	CameraCollisionSlowSpeed = 10.f;
+	CameraCollisionFastSpeed = 100.f;
+	CameraCollisionSpeedWindow = 0.05f;
+	bFadeCameraFromStaticDistanceField = true;
+	StaticCollisionFadeStartDistance = 20.f;
+	StaticCollisionFadeFullDistance = 5.f;
+	StaticCollisionCameraFadeAmount = 0.f;
+	TimeSinceCameraCollisionCheck = 0.f;
+	bCameraCollisionTracePending = false;
+	bCameraCollisionTraceStale = false;
+	CameraCollisionTraceDelegate.BindUObject(this, &ADVRPlayerCharacter::OnCameraCollisionTraceCompleted);
+	CameraCollisionQueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(CameraCollision), false);
 	TeleportCamerFadeOutTime = 0.25f;
+	MaxTeleportDestinationWaitTime = 5.f;
 	CameraCollisionFadeRate = 1.25f;
 
-	CameraCollisionState = ECameraCollisionState::ECCS_NotFading;
-
-	bTeleportInProgress = false;
+	TeleportState = ETeleportState::ETS_Idle;
+	bTeleportDestinationPending = false;
+	TeleportDestinationWaitTime = 0.f;
+	CharacterTransformUpdateCount = 0;
+	LastFrameCharacterTransformUpdateCount = 0;
 }
 
 /*******************************************************************/
@@ -57,18 +94,39 @@ void ADVRPlayerCharacter::BeginPlay()
 	// For Dev using Index (steamVR)
 	UHeadMountedDisplayFunctionLibrary::SetTrackingOrigin(EHMDTrackingOrigin::Floor);
 
-	// CameraComp collision detection is from swept movement. This is done slower than game frame rate to save on performance
-	GetWorld()->GetTimerManager().SetTimer(TimerHandle_CheckCameraCollision, this, &ADVRPlayerCharacter::CheckForCameraCollision, CameraCollisionCheckRate, true);
+	// CameraComp collision detection is from swept movement, issued from Tick at a rate based on HMD speed. See UpdateCameraCollisionCheck()
+	UpdateCameraCollisionQueryParams();
 	if (CameraComp)
 	{
 		LastCameraCollisionCompLocation = CameraComp->GetComponentLocation();
 	}
 
-	// Cache PlayerCameraManager
-	if (APlayerController* PlayerController = Cast<APlayerController>(GetController()))
+	// Head alerts interactables using the proximity service
+	if (UDInteractableProximitySubsystem* ProximitySubsystem = GetWorld()->GetSubsystem<UDInteractableProximitySubsystem>())
 	{
-		PlayerCameraManager = PlayerController->PlayerCameraManager;
+		ProximitySubsystem->RegisterProximitySource(CameraCollisionComp);
 	}
+
+	// Cache static distance field, maps without a baked distance field only use camera collision sweeps
+	UDStaticDistanceFieldSubsystem* DistanceFieldSubsystem = GetWorld()->GetSubsystem<UDStaticDistanceFieldSubsystem>();
+	if (bFadeCameraFromStaticDistanceField && DistanceFieldSubsystem && DistanceFieldSubsystem->HasDistanceField())
+	{
+		StaticDistanceFieldSubsystem = DistanceFieldSubsystem;
+	}
+
+#if !UE_BUILD_SHIPPING
+
+	// Count transform updates of room scale hierarchy, see stat DungeonEscapeVR
+	USceneComponent* CharacterComponents[] = { GetCapsuleComponent(), VRCenter, CameraComp };
+	for (USceneComponent* CharacterComponent : CharacterComponents)
+	{
+		if (CharacterComponent)
+		{
+			CharacterComponent->TransformUpdated.AddUObject(this, &ADVRPlayerCharacter::OnCharacterComponentTransformUpdated);
+		}
+	}
+
+#endif
 }
 
 
@@ -133,11 +191,18 @@ void ADVRPlayerCharacter::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	LastFrameCharacterTransformUpdateCount = CharacterTransformUpdateCount;
+	CharacterTransformUpdateCount = 0;
+
+	UpdateHMDPoseHistory();
+
 	AlignRootToVRRoot();
 
-	if (CameraCollisionState != ECameraCollisionState::ECCS_NotFading)
+	UpdateCameraCollisionCheck(DeltaTime);
+
+	if (StaticDistanceFieldSubsystem)
 	{
-		CameraCollisionFade(DeltaTime);
+		UpdateStaticCollisionCameraFade();
 	}
 }
 
@@ -145,96 +210,266 @@ void ADVRPlayerCharacter::Tick(float DeltaTime)
 
 void ADVRPlayerCharacter::AlignRootToVRRoot()
 {
-	if (CameraComp && VRCenter && !bInPauseMenu && !bTeleportInProgress)
+	SCOPE_CYCLE_COUNTER(STAT_AlignRootToVRRoot);
+
+	if (CameraComp && VRCenter && GetCapsuleComponent() && !bInPauseMenu && !IsTeleportInProgress())
 	{
 		// Align Root component to VRRoot, (room scaling)
 		// displacement of camera (HMD) from root component
 		FVector NewCameraOffset = CameraComp->GetComponentLocation() - GetActorLocation();
 		NewCameraOffset.Z = 0.f;
+
+		// Head has not moved far enough from capsule to be worth moving the whole hierarchy
+		if (NewCameraOffset.SizeSquared() <= FMath::Square(RoomScaleAlignmentDeadZone)) return;
+
+		// Defer transform propagation until both moves are done. VRCenter ends up where it started in world space, so its children
+		// (CameraComp, motion controllers and their components) are not updated at all instead of being moved and moved back
+		FScopedMovementUpdate ScopedCapsuleMovement(GetCapsuleComponent(), EScopedUpdate::DeferredUpdates);
+		FScopedMovementUpdate ScopedVRCenterMovement(VRCenter, EScopedUpdate::DeferredUpdates);
+
+		const FVector PreviousActorLocation = GetActorLocation();
 		AddActorWorldOffset(NewCameraOffset, true);
 
-		// move VRCenter back to its position before camera movement
-		VRCenter->AddWorldOffset(-NewCameraOffset);
+		// Sweep may have been blocked, only move VRCenter back by the distance capsule actually moved. VRCenter's world transform
+		// is stale while capsule updates are deferred, so move it back relative to capsule
+		const FVector MovedOffset = GetActorLocation() - PreviousActorLocation;
+		VRCenter->AddRelativeLocation(-GetActorTransform().InverseTransformVectorNoScale(MovedOffset));
 	}
 }
 
-void ADVRPlayerCharacter::CameraCollisionFade(float DeltaTime)
+
+void ADVRPlayerCharacter::UpdateHMDPoseHistory()
 {
-	if (CameraCollisionState == ECameraCollisionState::ECCS_FadeOut)
+	FVector HMDLocation;
+	FRotator HMDRotation;
+	GetTrackedHMDPose(HMDRotation, HMDLocation);
+	HMDPoseHistory.AddPose(FApp::GetCurrentTime(), HMDLocation, HMDRotation.Quaternion());
+
+	// Relocated frame was rendered with the HMD pose at its late update, wait until poses either side of it are tracked
+	FVector LateUpdateHMDLocation;
+	if (bMeasureRelocationError && VRCenter && HMDPoseHistory.GetLocationAtTime(RelocationLateUpdateTime, LateUpdateHMDLocation))
 	{
-		CollisionCameraFadeAmount += DeltaTime * CameraCollisionFadeRate;
+		bMeasureRelocationError = false;
+
+		const FVector RenderedHMDLocation = VRCenter->GetComponentTransform().TransformPosition(LateUpdateHMDLocation);
+		LastRelocationError = FVector::DistXY(RenderedHMDLocation, RelocationIntendedHMDLocation);
+		SET_FLOAT_STAT(STAT_RelocationHMDError, LastRelocationError);
 	}
-	else if (CameraCollisionState == ECameraCollisionState::ECCS_FadeIn)
+}
+
+
+FVector ADVRPlayerCharacter::SampleRelocationHMDLocation()
+{
+	// Sample again, relocation can happen from input or timers before this frame's tick. A stale history, e.g. after pause,
+	// has no poses inside the velocity window so no velocity is estimated
+	FVector HMDLocation;
+	FRotator HMDRotation;
+	GetTrackedHMDPose(HMDRotation, HMDLocation);
+	HMDPoseHistory.AddPose(FApp::GetCurrentTime(), HMDLocation, HMDRotation.Quaternion());
+
+	// Relocation is rendered this frame, with the HMD pose the render thread samples at its late update
+	const float LateUpdateGap = GetLateUpdateGap();
+	RelocationLateUpdateTime = FApp::GetCurrentTime() + LateUpdateGap;
+	if (bPredictHMDLocationOnRelocation)
 	{
-		CollisionCameraFadeAmount -= DeltaTime * CameraCollisionFadeRate;
+		HMDPoseHistory.PredictLocation(HMDPredictionVelocityWindow, LateUpdateGap, HMDLocation);
 	}
 
-	CollisionCameraFadeAmount = FMath::Clamp(CollisionCameraFadeAmount, 0.f, 1.f);
+	return HMDLocation;
+}
+
 
-	if (PlayerCameraManager)
+void ADVRPlayerCharacter::GetTrackedHMDPose(FRotator& OutRotation, FVector& OutLocation) const
+{
+	if (HMDLocationOverride.IsSet())
 	{
-		PlayerCameraManager->SetManualCameraFade(CollisionCameraFadeAmount, CameraCollisionFadeColor, false);
+		OutRotation = FRotator::ZeroRotator;
+		OutLocation = HMDLocationOverride.GetValue();
+		return;
 	}
 
-	if (CollisionCameraFadeAmount <= 0.f || CollisionCameraFadeAmount >= 1.f)
+	UHeadMountedDisplayFunctionLibrary::GetOrientationAndPosition(OutRotation, OutLocation);
+}
+
+
+float ADVRPlayerCharacter::GetLateUpdateGap() const
+{
+	if (LateUpdateGapOverride.IsSet()) return LateUpdateGapOverride.GetValue();
+
+	// Game thread time of this frame so far, FApp current time is taken when the frame starts
+	const float GameThreadTime = FPlatformTime::ToSeconds(GGameThreadTime);
+	const float ElapsedGameThreadTime = static_cast<float>(FPlatformTime::Seconds() - FApp::GetCurrentTime());
+	return FMath::Clamp(GameThreadTime - ElapsedGameThreadTime, 0.f, GameThreadTime);
+}
+
+
+void ADVRPlayerCharacter::RelocateVRCenter(const FVector& HMDTargetLocation, const FVector& HMDLocation, const FRotator& NewRotation, float NewHeight, ETeleportType Teleport)
+{
+	if (!VRCenter) return;
+
+	const FVector NewLocation = GetRelocatedVRCenterLocation(HMDTargetLocation, HMDLocation, NewRotation, NewHeight);
+	VRCenter->SetWorldLocationAndRotation(NewLocation, NewRotation, false, nullptr, Teleport);
+
+	ResetMotionControllerPoseHistory();
+	ResetCameraCollisionSweep();
+
+	RelocationIntendedHMDLocation = FVector(HMDTargetLocation.X, HMDTargetLocation.Y, 0.f);
+	bMeasureRelocationError = true;
+}
+
+
+FVector ADVRPlayerCharacter::GetRelocatedVRCenterLocation(const FVector& HMDTargetLocation, const FVector& HMDLocation, const FRotator& NewRotation, float NewHeight)
+{
+	const FVector HMDOffset = NewRotation.RotateVector(FVector(HMDLocation.X, HMDLocation.Y, 0.f));
+	return FVector(HMDTargetLocation.X - HMDOffset.X, HMDTargetLocation.Y - HMDOffset.Y, NewHeight);
+}
+
+
+void ADVRPlayerCharacter::OnCharacterComponentTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	++CharacterTransformUpdateCount;
+	INC_DWORD_STAT(STAT_CharacterComponentTransformUpdates);
+}
+
+void ADVRPlayerCharacter::UpdateStaticCollisionCameraFade()
+{
+	if (!CameraComp || !CameraFadeComp) return;
+
+	// Teleport fades camera itself
+	float NewFadeAmount = 0.f;
+	if (TeleportState == ETeleportState::ETS_Idle && !bInPauseMenu)
 	{
-		CameraCollisionState = ECameraCollisionState::ECCS_NotFading;
+		const float Distance = StaticDistanceFieldSubsystem->GetDistanceToStaticCollision(CameraComp->GetComponentLocation());
+		NewFadeAmount = FMath::GetMappedRangeValueClamped(FVector2D(StaticCollisionFadeFullDistance, StaticCollisionFadeStartDistance), FVector2D(1.f, 0.f), Distance);
+	}
+
+	// Quantize so small head movements do not restart the fade every frame. With the default 15 cm fade range a step is about half a cm,
+	// and 32 steps are still a smooth fade. Only send fade to the render thread when the step changes
+	const float FadeStep = 1.f / 32.f;
+	NewFadeAmount = FMath::GridSnap(NewFadeAmount, FadeStep);
+	if (NewFadeAmount != StaticCollisionCameraFadeAmount)
+	{
+		StaticCollisionCameraFadeAmount = NewFadeAmount;
+		CameraFadeComp->StartFade(ECameraFadeChannel::ECFC_StaticCollision, NewFadeAmount, NewFadeAmount, 0.f, CameraCollisionFadeColor);
+	}
+}
+
+
+void ADVRPlayerCharacter::UpdateCameraCollisionCheck(float DeltaTime)
+{
+	if (!CameraComp || bCameraCollisionTracePending) return;
+
+	TimeSinceCameraCollisionCheck += DeltaTime;
+
+	// Current HMD speed in tracking space, teleports and snap turns do not count. Fast head movement into a wall needs to be caught
+	// within a frame, a still head rarely needs checking. Without enough poses to estimate speed check as if moving fast
+	FVector HMDVelocity;
+	FVector HMDAngularVelocity;
+	const bool bHasSpeed = HMDPoseHistory.EstimateVelocity(CameraCollisionSpeedWindow, HMDVelocity, HMDAngularVelocity);
+	const float CameraSpeed = bHasSpeed ? HMDVelocity.Size() : CameraCollisionFastSpeed;
+	const float CheckInterval = FMath::GetMappedRangeValueClamped(FVector2D(CameraCollisionSlowSpeed, CameraCollisionFastSpeed), FVector2D(CameraCollisionCheckRate, 0.f), CameraSpeed);
+
+	if (TimeSinceCameraCollisionCheck >= CheckInterval)
+	{
+		CheckForCameraCollision();
+		TimeSinceCameraCollisionCheck = 0.f;
 	}
 }
 
 
 void ADVRPlayerCharacter::CheckForCameraCollision()
 {
-	if (CameraCollisionComp && CameraComp && !bTeleportInProgress && !bInPauseMenu)
+	if (CameraCollisionComp && CameraComp && !IsTeleportInProgress() && !bInPauseMenu)
 	{
 		// do not allow motion controllers or currently held objects to activate camera collision
-		TArray<AActor*> IgnoreActors;
-		IgnoreActors.Add(this);
-		if (LeftMotionController)
-		{
-			IgnoreActors.Add(LeftMotionController);
-			if (LeftMotionController->IsGrabbingActor())
-			{
-				IgnoreActors.Add(LeftMotionController->GetCurrentGrabbedActor());
-			}
-		}
-		if (RightMotionController)
-		{
-			IgnoreActors.Add(RightMotionController);
-			if (RightMotionController->IsGrabbingActor())
-			{
-				IgnoreActors.Add(RightMotionController->GetCurrentGrabbedActor());
-			}
-		}
+		UpdateCameraCollisionQueryParams();
 
-		FHitResult HitResult;
 		const FVector CurrentCameraLocation = CameraComp->GetComponentLocation();
-		bool bHit = UKismetSystemLibrary::SphereTraceSingle(
-			GetWorld(),
+		GetWorld()->AsyncSweepByChannel(
+			EAsyncTraceType::Single,
 			LastCameraCollisionCompLocation,
 			CurrentCameraLocation,
-			CameraCollisionComp->GetScaledSphereRadius(),
-			UEngineTypes::ConvertToTraceType(ECollisionChannel::ECC_Visibility),
-			false,
-			IgnoreActors,
-			EDrawDebugTrace::None,
-			HitResult,
-			true
+			FQuat::Identity,
+			ECollisionChannel::ECC_Visibility,
+			FCollisionShape::MakeSphere(CameraCollisionComp->GetScaledSphereRadius()),
+			CameraCollisionQueryParams,
+			FCollisionResponseParams::DefaultResponseParam,
+			&CameraCollisionTraceDelegate
 		);
+		bCameraCollisionTracePending = true;
+
+		CameraCollisionComp->SetWorldLocation(CurrentCameraLocation);
+		LastCameraCollisionCompLocation = CurrentCameraLocation;
+	}
+}
+
+
+void ADVRPlayerCharacter::OnCameraCollisionTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	bCameraCollisionTracePending = false;
+
+	// Player teleported or snap turned while sweep was in flight, result is for the old location
+	const bool bStale = bCameraCollisionTraceStale;
+	bCameraCollisionTraceStale = false;
+	if (bStale || IsTeleportInProgress() || bInPauseMenu) return;
+
+	const bool bHit = TraceDatum.OutHits.Num() > 0 && TraceDatum.OutHits[0].bBlockingHit;
+	if (bCameraCollisionOverlapping != bHit)
+	{
+		bCameraCollisionOverlapping = bHit;
 
-		if (!bCameraCollisionOverlapping && bHit)
+		// Fade is interpolated on the render thread, only the change is sent
+		if (CameraFadeComp)
 		{
-			bCameraCollisionOverlapping = true;
-			CameraCollisionState = ECameraCollisionState::ECCS_FadeOut;
+			CameraFadeComp->FadeTo(ECameraFadeChannel::ECFC_Collision, bHit ? 1.f : 0.f, CameraCollisionFadeRate, CameraCollisionFadeColor);
 		}
-		else if (bCameraCollisionOverlapping && !bHit)
+	}
+}
+
+
+void ADVRPlayerCharacter::ResetCameraCollisionSweep()
+{
+	if (CameraCollisionComp && CameraComp)
+	{
+		// Sweeping from the location before relocation would sweep across the level
+		LastCameraCollisionCompLocation = CameraComp->GetComponentLocation();
+		CameraCollisionComp->SetWorldLocation(LastCameraCollisionCompLocation);
+	}
+
+	bCameraCollisionTraceStale = bCameraCollisionTracePending;
+}
+
+
+void ADVRPlayerCharacter::UpdateCameraCollisionQueryParams()
+{
+	ADVRMotionController* MotionControllers[] = { LeftMotionController, RightMotionController };
+
+	bool bGrabbedActorsChanged = false;
+	for (int32 i = 0; i < 2; ++i)
+	{
+		AActor* GrabbedActor = MotionControllers[i] ? MotionControllers[i]->GetCurrentGrabbedActor() : nullptr;
+		if (CameraCollisionIgnoredGrabbedActors[i].Get() != GrabbedActor)
 		{
-			bCameraCollisionOverlapping = false;
-			CameraCollisionState = ECameraCollisionState::ECCS_FadeIn;
+			CameraCollisionIgnoredGrabbedActors[i] = GrabbedActor;
+			bGrabbedActorsChanged = true;
 		}
+	}
 
-		CameraCollisionComp->SetWorldLocation(CurrentCameraLocation);
-		LastCameraCollisionCompLocation = CurrentCameraLocation;
+	// Only rebuild ignored actors when a grabbed actor changed, query params are reused for every check otherwise
+	if (!bGrabbedActorsChanged && CameraCollisionQueryParams.GetIgnoredActors().Num() > 0) return;
+
+	CameraCollisionQueryParams.ClearIgnoredActors();
+	CameraCollisionQueryParams.AddIgnoredActor(this);
+	for (int32 i = 0; i < 2; ++i)
+	{
+		if (MotionControllers[i])
+		{
+			CameraCollisionQueryParams.AddIgnoredActor(MotionControllers[i]);
+		}
+		if (AActor* GrabbedActor = CameraCollisionIgnoredGrabbedActors[i].Get())
+		{
+			CameraCollisionQueryParams.AddIgnoredActor(GrabbedActor);
+		}
 	}
 }
 
@@ -315,23 +550,42 @@ void ADVRPlayerCharacter::ReleaseRight()
 
 
 void ADVRPlayerCharacter::TurnLeft()
+{
+	SnapTurn(-DegreesOnTurn);
+}
+
+
+void ADVRPlayerCharacter::TurnRight()
+{
+	SnapTurn(DegreesOnTurn);
+}
+
+
+void ADVRPlayerCharacter::SnapTurn(float Degrees)
 {
 	if (VRCenter)
 	{
-		FRotator Rotation = VRCenter->GetComponentRotation();
-		Rotation.Yaw -= DegreesOnTurn;
-		VRCenter->SetWorldRotation(Rotation);
+		FRotator NewRotation = VRCenter->GetComponentRotation();
+		NewRotation.Yaw += Degrees;
+
+		// Pivot around the head, rotating around VRCenter would swing the player around the center of the play area
+		const FVector HMDLocation = SampleRelocationHMDLocation();
+		const FVector HMDWorldLocation = VRCenter->GetComponentTransform().TransformPosition(FVector(HMDLocation.X, HMDLocation.Y, 0.f));
+		RelocateVRCenter(HMDWorldLocation, HMDLocation, NewRotation, VRCenter->GetComponentLocation().Z, ETeleportType::None);
 	}
 }
 
 
-void ADVRPlayerCharacter::TurnRight()
+void ADVRPlayerCharacter::ResetMotionControllerPoseHistory() const
 {
-	if (VRCenter)
+	if (LeftMotionController)
 	{
-		FRotator Rotation = VRCenter->GetComponentRotation();
-		Rotation.Yaw += DegreesOnTurn;
-		VRCenter->SetWorldRotation(Rotation);
+		LeftMotionController->ResetPoseHistory();
+	}
+
+	if (RightMotionController)
+	{
+		RightMotionController->ResetPoseHistory();
 	}
 }
 
@@ -374,7 +628,7 @@ void ADVRPlayerCharacter::RightTriggerRelease()
 
 void ADVRPlayerCharacter::StartFindTeleportDestination()
 {
-	if (LeftMotionController && !bWantsToTeleport && !bInPauseMenu)
+	if (LeftMotionController && !bWantsToTeleport && !bInPauseMenu && !IsTeleportInProgress())
 	{
 		bWantsToTeleport = true;
 		LeftMotionController->StartFindTeleportDestination();
@@ -387,11 +641,15 @@ void ADVRPlayerCharacter::FinishFindTeleportDestination()
 	if (LeftMotionController && bWantsToTeleport && !bInPauseMenu)
 	{
 		bWantsToTeleport = false;
-		bool ValidTeleportLocation = LeftMotionController->GetCurrentTeleportDestinationMarketLocation(DesiredTeleportLocation);
-		if (ValidTeleportLocation)
+		FVector TeleportLocation;
+		bool ValidTeleportLocation = LeftMotionController->GetCurrentTeleportDestinationMarketLocation(TeleportLocation);
+		LeftMotionController->StopFindTeleportDestination();
+
+		// Release is always consumed, only the relocation is dropped while another teleport is running.
+		// Destination of the running teleport is kept until it relocates the player in FinishTeleport()
+		if (ValidTeleportLocation && BeginTeleport(false)) // do not teleport to pause menu location
 		{
-			LeftMotionController->StopFindTeleportDestination();
-			BeginTeleport(false); // do not teleport to pause menu location
+			DesiredTeleportLocation = TeleportLocation;
 		}
 	}
 }
@@ -401,11 +659,21 @@ void ADVRPlayerCharacter::FinishFindTeleportDestination()
 /* Teleport */
 /*******************************************************************/
 
-void ADVRPlayerCharacter::BeginTeleport(bool TeleportToPauseMenu)
+bool ADVRPlayerCharacter::BeginTeleport(bool TeleportToPauseMenu)
 {
-	bTeleportInProgress = true;
+	// Player has not been relocated for the current request yet
+	if (TeleportState == ETeleportState::ETS_FadingOut) return false;
+
+	// Interrupt fade in of previous teleport
+	GetWorldTimerManager().ClearTimer(TimerHandle_Teleport);
+	TeleportState = ETeleportState::ETS_FadingOut;
+	TeleportDestinationWaitTime = 0.f;
+
 	float TeleportTimeDelay = 0.f;
 
+	// Time for camera to fade to black, pause menu teleports cut to black
+	float BlackoutDelay = 0.f;
+
 	// Teleport to pause menu
 	if (!bInPauseMenu && TeleportToPauseMenu)
 	{
@@ -424,13 +692,25 @@ void ADVRPlayerCharacter::BeginTeleport(bool TeleportToPauseMenu)
 	else
 	{
 		TeleportTimeDelay = TeleportTime;
+		BlackoutDelay = TeleportTime / 2.f;
 		SetupTeleport();
 	}
 
 	OnPlayerBeginTeleport.Broadcast();
 
-	FTimerHandle TimerHandle_TeleportCameraFade;
-	GetWorldTimerManager().SetTimer(TimerHandle_TeleportCameraFade, this, &ADVRPlayerCharacter::FinishTeleport, TeleportTimeDelay, false);
+	if (UDInteractableOutlineSubsystem* OutlineSubsystem = GetWorld()->GetSubsystem<UDInteractableOutlineSubsystem>())
+	{
+		OutlineSubsystem->SetPlayerTeleporting(true);
+	}
+
+	// Run deferred work while the view is black, see UDTeleportBlackoutSubsystem
+	if (UDTeleportBlackoutSubsystem* BlackoutSubsystem = GetWorld()->GetSubsystem<UDTeleportBlackoutSubsystem>())
+	{
+		BlackoutSubsystem->OpenBlackoutWindow(BlackoutDelay);
+	}
+
+	GetWorldTimerManager().SetTimer(TimerHandle_Teleport, this, &ADVRPlayerCharacter::FinishTeleport, TeleportTimeDelay, false);
+	return true;
 }
 
 
@@ -442,9 +722,6 @@ void ADVRPlayerCharacter::SetupTeleportToPauseMenuLocation()
 	{
 		RightMotionController->SetControllerMode(EControllerMode::ECM_UI);
 	}
-
-	FTimerHandle TimerHandle_Teleport;
-	GetWorldTimerManager().SetTimer(TimerHandle_Teleport, this, &ADVRPlayerCharacter::FinishTeleport, 0.2f, false);
 }
 
 	
@@ -467,36 +744,84 @@ void ADVRPlayerCharacter::SetupTeleport()
 
 void ADVRPlayerCharacter::FinishTeleport()
 {	
-	if (VRCenter)
+	if (TeleportState != ETeleportState::ETS_FadingOut) return;
+
+	// Hold in the fade until destination is known
+	if (bTeleportDestinationPending)
 	{
-		// Compute teleport location based on current head mounted display location
-		FVector HMDLocation;
-		FRotator HMDRotation;
-		UHeadMountedDisplayFunctionLibrary::GetOrientationAndPosition(HMDRotation, HMDLocation);
-		HMDLocation.Z = 0.f;
-		DesiredTeleportLocation -= HMDLocation;
+		const float RetryInterval = 0.05f;
+		if (TeleportDestinationWaitTime < MaxTeleportDestinationWaitTime)
+		{
+			TeleportDestinationWaitTime += RetryInterval;
+			GetWorldTimerManager().SetTimer(TimerHandle_Teleport, this, &ADVRPlayerCharacter::FinishTeleport, RetryInterval, false);
+			return;
+		}
 
-		VRCenter->SetWorldLocationAndRotation(DesiredTeleportLocation, VRCenter->GetComponentRotation(), false, nullptr, ETeleportType::TeleportPhysics);
+		// Destination never arrived, e.g. pause room failed to stream in. Do not leave player in the dark, fade back in where they are
+		UE_LOG(LogDungeonEscapeVR, Warning, TEXT("Teleport destination still pending after %.1f s, teleport abandoned"), MaxTeleportDestinationWaitTime);
+		bTeleportDestinationPending = false;
+		if (VRCenter)
+		{
+			DesiredTeleportLocation = SampleRelocationHMDLocation();
+			DesiredTeleportLocation.Z = VRCenter->GetComponentLocation().Z;
+		}
+
+		// Not paused, so controller unloads the pause room once relocated
+		if (bInPauseMenu)
+		{
+			bInPauseMenu = false;
+			if (RightMotionController)
+			{
+				RightMotionController->SetControllerMode(EControllerMode::ECM_Game);
+			}
+		}
+	}
+
+	TeleportState = ETeleportState::ETS_FadingIn;
+	GetWorldTimerManager().SetTimer(TimerHandle_Teleport, this, &ADVRPlayerCharacter::OnTeleportFadeInFinished, TeleportTime / 2.f, false);
+
+	if (UDTeleportBlackoutSubsystem* BlackoutSubsystem = GetWorld()->GetSubsystem<UDTeleportBlackoutSubsystem>())
+	{
+		BlackoutSubsystem->CloseBlackoutWindow();
+	}
+
+	if (VRCenter)
+	{
+		// Land head mounted display, not the center of the play area, on DesiredTeleportLocation
+		const FVector HMDLocation = SampleRelocationHMDLocation();
+		RelocateVRCenter(DesiredTeleportLocation, HMDLocation, VRCenter->GetComponentRotation(), DesiredTeleportLocation.Z, ETeleportType::TeleportPhysics);
 
 		StartTeleportCameraFade(1.f, 0.f, TeleportTime / 2.f);
 
 		OnPlayerFinishTeleport.Broadcast();
 
+		if (UDInteractableOutlineSubsystem* OutlineSubsystem = GetWorld()->GetSubsystem<UDInteractableOutlineSubsystem>())
+		{
+			OutlineSubsystem->SetPlayerTeleporting(false);
+		}
+
 		if (ADVRPlayerController* VRPlayerController = GetController<ADVRPlayerController>())
 		{
 			VRPlayerController->PlayerCharacterInPauseMenu(bInPauseMenu);
 		}
 	}
+}
+
 
-	bTeleportInProgress = false;
+void ADVRPlayerCharacter::OnTeleportFadeInFinished()
+{
+	if (TeleportState == ETeleportState::ETS_FadingIn)
+	{
+		TeleportState = ETeleportState::ETS_Idle;
+	}
 }
 
 
 void ADVRPlayerCharacter::StartTeleportCameraFade(float FromAlpha, float ToAlpha, float Time)
 {
-	if (PlayerCameraManager)
+	if (CameraFadeComp)
 	{
-		PlayerCameraManager->StartCameraFade(FromAlpha, ToAlpha, Time, TeleportCameraFadeColor, false, true);
+		CameraFadeComp->StartFade(ECameraFadeChannel::ECFC_Teleport, FromAlpha, ToAlpha, Time, TeleportCameraFadeColor);
 	}
 }
 
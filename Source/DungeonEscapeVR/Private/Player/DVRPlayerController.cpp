@@ -9,6 +9,7 @@
 
 
 // Game Includes
+#include "../DungeonEscapeVR.h"
 #include "Player/DVRPlayerCharacter.h"
 
 
@@ -21,9 +22,12 @@ void ADVRPlayerController::BeginPlay()
 
 	VRPlayerCharacter = GetPawn<ADVRPlayerCharacter>();
 
-	bLevelHasPauseLocation = GetPauseMenuLocation();
-
-	PauseMenuLayoutActor = FindFirstActorWithTag(PauseMenuLayoutActorTag);
+	// Pause room actors are found once the pause room level is loaded, see OnPauseRoomLoaded()
+	if (PauseRoomLevelName.IsNone())
+	{
+		bLevelHasPauseLocation = GetPauseMenuLocation();
+		PauseMenuLayoutActor = FindFirstActorWithTag(PauseMenuLayoutActorTag);
+	}
 }
 
 
@@ -61,24 +65,68 @@ void ADVRPlayerController::SetupInputComponent()
 
 void ADVRPlayerController::PauseGame()
 {
-	if (bLevelHasPauseLocation && !UGameplayStatics::IsGamePaused(GetWorld()) && VRPlayerCharacter)
+	const bool bCanPause = bLevelHasPauseLocation || !PauseRoomLevelName.IsNone();
+	if (bCanPause && !UGameplayStatics::IsGamePaused(GetWorld()) && VRPlayerCharacter && !VRPlayerCharacter->IsTeleportInProgress())
 	{
-		float VRPlayerCharacterYaw = VRPlayerCharacter->GetPlayerViewRotation().Yaw;
-		if (PauseMenuLayoutActor)
+		PlayerViewYawWhenPaused = VRPlayerCharacter->GetPlayerViewRotation().Yaw;
+		PlayerLocationWhenPaused = VRPlayerCharacter->GetActorLocation();
+		PlayerLocationWhenPaused.Z = 0;
+
+		if (PauseRoomLevelName.IsNone())
+		{
+			SetupPauseMenuLayout();
+			VRPlayerCharacter->SetDesiredTeleportLocation(PlayerPauseMenuLocation);
+		}
+		else
 		{
-			FRotator PauseMenuLayoutActorRotation = PauseMenuLayoutActor->GetActorRotation();
-			PauseMenuLayoutActorRotation.Yaw = VRPlayerCharacterYaw;
-			PauseMenuLayoutActor->SetActorRotation(PauseMenuLayoutActorRotation);
+			// Stream in pause room while camera fades out. Player is held in the fade until OnPauseRoomLoaded() sets the destination
+			VRPlayerCharacter->SetTeleportDestinationPending();
+			bPauseRoomRequested = true;
+
+			FLatentActionInfo LatentInfo;
+			LatentInfo.CallbackTarget = this;
+			LatentInfo.ExecutionFunction = GET_FUNCTION_NAME_CHECKED(ADVRPlayerController, OnPauseRoomLoaded);
+			LatentInfo.UUID = GetUniqueID();
+			LatentInfo.Linkage = 0;
+			UGameplayStatics::LoadStreamLevel(this, PauseRoomLevelName, true, false, LatentInfo);
 		}
 
-		PlayerLocationWhenPaused = VRPlayerCharacter->GetActorLocation();
-		PlayerLocationWhenPaused.Z = 0;
-		VRPlayerCharacter->SetDesiredTeleportLocation(PlayerPauseMenuLocation);
 		VRPlayerCharacter->BeginTeleport(true);	// teleport to pause menu location
 	}
 }
 
 
+void ADVRPlayerController::OnPauseRoomLoaded()
+{
+	// Pause may have been abandoned while streaming, see ADVRPlayerCharacter::FinishTeleport()
+	if (!VRPlayerCharacter || !bPauseRoomRequested) return;
+
+	bLevelHasPauseLocation = GetPauseMenuLocation();
+	PauseMenuLayoutActor = FindFirstActorWithTag(PauseMenuLayoutActorTag);
+
+	if (!bLevelHasPauseLocation)
+	{
+		// Do not leave player waiting in the fade, pause where they are
+		UE_LOG(LogDungeonEscapeVR, Warning, TEXT("Pause room level %s has no actor tagged %s"), *PauseRoomLevelName.ToString(), *PlayerPauseLocationActorTag.ToString());
+		PlayerPauseMenuLocation = PlayerLocationWhenPaused;
+	}
+
+	SetupPauseMenuLayout();
+	VRPlayerCharacter->SetDesiredTeleportLocation(PlayerPauseMenuLocation);
+}
+
+
+void ADVRPlayerController::SetupPauseMenuLayout()
+{
+	if (PauseMenuLayoutActor)
+	{
+		FRotator PauseMenuLayoutActorRotation = PauseMenuLayoutActor->GetActorRotation();
+		PauseMenuLayoutActorRotation.Yaw = PlayerViewYawWhenPaused;
+		PauseMenuLayoutActor->SetActorRotation(PauseMenuLayoutActorRotation);
+	}
+}
+
+
 void ADVRPlayerController::ReturnToGame()
 {
 	UGameplayStatics::SetGamePaused(GetWorld(), false);
@@ -90,6 +138,22 @@ void ADVRPlayerController::ReturnToGame()
 }
 
 
+void ADVRPlayerController::UnloadPauseRoom()
+{
+	if (!bPauseRoomRequested) return;
+
+	bPauseRoomRequested = false;
+	PauseMenuLayoutActor = nullptr;
+	bLevelHasPauseLocation = false;
+
+	FLatentActionInfo LatentInfo;
+	LatentInfo.CallbackTarget = this;
+	LatentInfo.UUID = GetUniqueID() + 1;
+	LatentInfo.Linkage = 0;
+	UGameplayStatics::UnloadStreamLevel(this, PauseRoomLevelName, LatentInfo, false);
+}
+
+
 /*******************************************************************/
 /* Gameplay State progression */
 /*******************************************************************/
@@ -118,6 +182,12 @@ void ADVRPlayerController::PlayerCharacterInPauseMenu(bool Value)
 	{
 		UGameplayStatics::SetGamePaused(GetWorld(), Value);
 	}
+
+	// Player has left the pause room, unloading it earlier would drop the floor from under the player before the relocation
+	if (!Value)
+	{
+		UnloadPauseRoom();
+	}
 }
 
 
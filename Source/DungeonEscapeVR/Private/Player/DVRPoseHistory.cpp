@@ -0,0 +1,129 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Player/DVRPoseHistory.h"
+
+
+void FDVRPoseHistory::AddPose(double Time, const FVector& Location, const FQuat& Rotation)
+{
+	// Same timestamp as newest pose, e.g. added twice in one frame. Keep latest pose, a zero time step breaks the fit
+	if (NumPoses > 0)
+	{
+		const int32 NewestIndex = (Head + CAPACITY - 1) % CAPACITY;
+		if (Time <= Poses[NewestIndex].Time)
+		{
+			Poses[NewestIndex] = { Poses[NewestIndex].Time, Location, Rotation };
+			return;
+		}
+	}
+
+	Poses[Head] = { Time, Location, Rotation };
+	Head = (Head + 1) % CAPACITY;
+	NumPoses = FMath::Min(NumPoses + 1, CAPACITY);
+}
+
+
+void FDVRPoseHistory::Reset()
+{
+	Head = 0;
+	NumPoses = 0;
+}
+
+
+bool FDVRPoseHistory::EstimateVelocity(float Window, FVector& OutLinearVelocity, FVector& OutAngularVelocity) const
+{
+	OutLinearVelocity = FVector::ZeroVector;
+	OutAngularVelocity = FVector::ZeroVector;
+
+	if (NumPoses < 2) return false;
+
+	const FTimedPose& Newest = Poses[(Head + CAPACITY - 1) % CAPACITY];
+
+	// Fit Value = A + B * t for each axis, B is the velocity. Times and values are relative to the newest pose to keep
+	// precision, rotations are expressed as rotation vectors from the newest rotation so they can be fit like locations
+	float SumT = 0.f;
+	float SumTT = 0.f;
+	FVector SumL = FVector::ZeroVector;
+	FVector SumTL = FVector::ZeroVector;
+	FVector SumR = FVector::ZeroVector;
+	FVector SumTR = FVector::ZeroVector;
+	int32 Count = 0;
+
+	for (int32 i = 0; i < NumPoses; ++i)
+	{
+		const FTimedPose& Pose = Poses[(Head + CAPACITY - 1 - i) % CAPACITY];
+
+		const float T = static_cast<float>(Pose.Time - Newest.Time);
+		if (-T > Window) break;
+
+		const FVector L = Pose.Location - Newest.Location;
+
+		FQuat Delta = Pose.Rotation * Newest.Rotation.Inverse();
+		if (Delta.W < 0.f)
+		{
+			// Shortest path
+			Delta = Delta * -1.f;
+		}
+		const FVector R = Delta.GetRotationAxis() * Delta.GetAngle();
+
+		SumT += T;
+		SumTT += T * T;
+		SumL += L;
+		SumTL += T * L;
+		SumR += R;
+		SumTR += T * R;
+		++Count;
+	}
+
+	const float Denominator = Count * SumTT - SumT * SumT;
+	if (Count < 2 || FMath::IsNearlyZero(Denominator)) return false;
+
+	OutLinearVelocity = (Count * SumTL - SumT * SumL) / Denominator;
+	OutAngularVelocity = (Count * SumTR - SumT * SumR) / Denominator;
+	return true;
+}
+
+
+bool FDVRPoseHistory::PredictLocation(float Window, float PredictionTime, FVector& OutLocation) const
+{
+	if (NumPoses == 0) return false;
+
+	OutLocation = Poses[(Head + CAPACITY - 1) % CAPACITY].Location;
+
+	FVector LinearVelocity;
+	FVector AngularVelocity;
+	if (EstimateVelocity(Window, LinearVelocity, AngularVelocity))
+	{
+		OutLocation += LinearVelocity * PredictionTime;
+	}
+
+	return true;
+}
+
+
+bool FDVRPoseHistory::GetLocationAtTime(double Time, FVector& OutLocation) const
+{
+	if (NumPoses == 0) return false;
+
+	const FTimedPose* Later = &Poses[(Head + CAPACITY - 1) % CAPACITY];
+	if (Time > Later->Time) return false;
+
+	for (int32 i = 1; i < NumPoses; ++i)
+	{
+		const FTimedPose& Earlier = Poses[(Head + CAPACITY - 1 - i) % CAPACITY];
+		if (Time >= Earlier.Time)
+		{
+			const float Alpha = static_cast<float>((Time - Earlier.Time) / (Later->Time - Earlier.Time));
+			OutLocation = FMath::Lerp(Earlier.Location, Later->Location, Alpha);
+			return true;
+		}
+
+		Later = &Earlier;
+	}
+
+	// Only an exact match of the oldest pose is left
+	if (Time < Later->Time) return false;
+
+	OutLocation = Later->Location;
+	return true;
+}
@@ -0,0 +1,150 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Engine Includes
+#include "Components/SphereComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+
+
+// Game Includes
+#include "Gameplay/DInteractableActor.h"
+#include "Gameplay/DInteractableProximitySubsystem.h"
+#include "Tests/DVRTestUtils.h"
+
+
+namespace
+{
+	/** Props in a square grid, dropped onto the floor so some are awake and some settle during the measured frames */
+	const int32 ProximityBenchmarkPropCount = 1024;
+	const float ProximityBenchmarkPropSpacing = 30.f;
+
+	/** Frames simulated before measuring, so dropped props have landed, and frames measured */
+	const int32 ProximityBenchmarkWarmUpFrames = 30;
+	const int32 ProximityBenchmarkFrames = 240;
+	const float ProximityBenchmarkDeltaTime = 1.f / 90.f;
+
+	struct FProximityBenchmarkResult
+	{
+		double TickSeconds;
+		int32 AlertedCount;
+		int32 RegisteredCount;
+	};
+
+	/** Hand sized pawn overlap sphere, moved across the props like the player's hand */
+	USphereComponent* SpawnProximitySource(UWorld* World)
+	{
+		AActor* SourceActor = World->SpawnActor<AActor>();
+		USphereComponent* Source = NewObject<USphereComponent>(SourceActor);
+		Source->InitSphereRadius(15.f);
+		Source->SetCollisionObjectType(ECollisionChannel::ECC_Pawn);
+		Source->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+		Source->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Overlap);
+		Source->SetGenerateOverlapEvents(true);
+		SourceActor->SetRootComponent(Source);
+		Source->RegisterComponent();
+		return Source;
+	}
+
+	/** Tick a fresh world of props, found by the proximity service if bUseProximityService or alert sphere overlaps otherwise */
+	FProximityBenchmarkResult RunProximityBenchmark(bool bUseProximityService)
+	{
+		static UStaticMesh* CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+
+		DVRTest::FTestWorld TestWorld;
+		UWorld* World = TestWorld.GetWorld();
+
+		const int32 GridSize = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(ProximityBenchmarkPropCount)));
+		const float GridExtent = GridSize * ProximityBenchmarkPropSpacing * 0.5f;
+		TestWorld.SpawnBox(FVector(0.f, 0.f, -5.f), FVector(GridExtent + 100.f, GridExtent + 100.f, 5.f), FRotator::ZeroRotator, EComponentMobility::Static);
+
+		TArray<ADInteractableActor*> Props;
+		Props.Reserve(ProximityBenchmarkPropCount);
+		for (int32 i = 0; i < ProximityBenchmarkPropCount; ++i)
+		{
+			// Alternate rows start higher, so props keep landing on each other during warm up
+			const FVector Location((i / GridSize) * ProximityBenchmarkPropSpacing - GridExtent, (i % GridSize) * ProximityBenchmarkPropSpacing - GridExtent, (i / GridSize) % 2 ? 60.f : 20.f);
+			const FTransform SpawnTransform(Location);
+
+			ADInteractableActor* Prop = World->SpawnActorDeferred<ADInteractableActor>(ADInteractableActor::StaticClass(), SpawnTransform);
+			if (!Prop) continue;
+
+			UStaticMeshComponent* MeshComp = Prop->FindComponentByClass<UStaticMeshComponent>();
+			MeshComp->SetMobility(EComponentMobility::Movable);
+			MeshComp->SetStaticMesh(CubeMesh);
+			MeshComp->SetWorldScale3D(FVector(0.2f));
+
+			// 50 cm alert radius after the prop scale, about what a hand reaches without stepping
+			Prop->FindComponentByClass<USphereComponent>()->SetSphereRadius(250.f);
+			Prop->SetUseProximityService(bUseProximityService);
+			Prop->FinishSpawning(SpawnTransform);
+			Props.Add(Prop);
+		}
+
+		USphereComponent* Source = SpawnProximitySource(World);
+		UDInteractableProximitySubsystem* ProximitySubsystem = World->GetSubsystem<UDInteractableProximitySubsystem>();
+		if (ProximitySubsystem)
+		{
+			ProximitySubsystem->RegisterProximitySource(Source);
+		}
+
+		FProximityBenchmarkResult Result;
+		Result.TickSeconds = 0.0;
+		Result.RegisteredCount = ProximitySubsystem ? ProximitySubsystem->GetNumRegisteredInteractables() : 0;
+
+		for (int32 Frame = 0; Frame < ProximityBenchmarkWarmUpFrames + ProximityBenchmarkFrames; ++Frame)
+		{
+			// Hand sweeps diagonally across the grid at the height of the landed props
+			const float Alpha = static_cast<float>(Frame) / (ProximityBenchmarkWarmUpFrames + ProximityBenchmarkFrames);
+			Source->SetWorldLocation(FMath::Lerp(FVector(-GridExtent, -GridExtent, 10.f), FVector(GridExtent, GridExtent, 10.f), Alpha));
+
+			const double StartTime = FPlatformTime::Seconds();
+			World->Tick(ELevelTick::LEVELTICK_All, ProximityBenchmarkDeltaTime);
+			if (Frame >= ProximityBenchmarkWarmUpFrames)
+			{
+				Result.TickSeconds += FPlatformTime::Seconds() - StartTime;
+			}
+		}
+
+		Result.AlertedCount = 0;
+		for (const ADInteractableActor* Prop : Props)
+		{
+			Result.AlertedCount += Prop->GetInteractionAlertTrigger() ? 1 : 0;
+		}
+
+		return Result;
+	}
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDInteractableProximityBenchmarkTest, "DungeonEscapeVR.Gameplay.InteractableProximity.Benchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FDInteractableProximityBenchmarkTest::RunTest(const FString& Parameters)
+{
+	const bool ProximityServiceModes[] = { false, true };
+	for (const bool bUseProximityService : ProximityServiceModes)
+	{
+		const FProximityBenchmarkResult Result = RunProximityBenchmark(bUseProximityService);
+
+		// Same props and physics in both runs, the difference is the overlap cost of the alert spheres against the proximity service
+		AddInfo(FString::Printf(TEXT("%d props %s proximity service: %.3f ms world tick per frame over %d frames, %d alerted at end"),
+			ProximityBenchmarkPropCount, bUseProximityService ? TEXT("with") : TEXT("without"), Result.TickSeconds * 1000.0 / ProximityBenchmarkFrames,
+			ProximityBenchmarkFrames, Result.AlertedCount));
+
+		TestEqual(FString::Printf(TEXT("Props registered %s proximity service"), bUseProximityService ? TEXT("with") : TEXT("without")),
+			Result.RegisteredCount, bUseProximityService ? ProximityBenchmarkPropCount : 0);
+		TestTrue(FString::Printf(TEXT("Props near the source alerted %s proximity service"), bUseProximityService ? TEXT("with") : TEXT("without")),
+			Result.AlertedCount > 0);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
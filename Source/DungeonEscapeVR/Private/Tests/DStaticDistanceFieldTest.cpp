@@ -0,0 +1,167 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+// Engine Includes
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+
+// Game Includes
+#include "Collision/DStaticDistanceField.h"
+#include "Tests/DVRTestUtils.h"
+
+
+namespace
+{
+	/** Bake settings of UDBuildDistanceFieldCommandlet */
+	const float DistanceFieldVoxelSize = 10.f;
+	const float DistanceFieldMaxDistance = 60.f;
+
+	/**
+	 * Error allowed against the physics scene, well inside the 5 - 20 cm static collision camera fade band. Trilinear filtering is exact
+	 * for distance to a plane except within a voxel diagonal of the surface, where samples inside collision are clamped to 0 instead of
+	 * going negative. At the edge of the fade band that adds up to about 2.2 cm, quantization another 0.12 cm
+	 */
+	const float DistanceFieldTolerance = 3.f;
+
+	/** Samples are taken across the fade band and a little past it. Camera is fully faded closer than 5 cm */
+	const float MinSampleDistance = 5.f;
+	const float MaxSampleDistance = 25.f;
+
+	/** Samples on each box */
+	const int32 SamplesPerBox = 200;
+
+	/** Bisection steps of the reference distance, MaxDistance / 2^14 is well under a millimetre */
+	const int32 ReferenceDistanceSteps = 14;
+
+	struct FDistanceFieldTestBox
+	{
+		FVector Center;
+		FVector Extent;
+		FRotator Rotation;
+	};
+
+	/** Radius of the largest sphere at Location clear of blocking collision, found by bisection with sphere overlap tests */
+	float GetReferenceDistance(UWorld* World, const FVector& Location, float MaxDistance)
+	{
+		const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(StaticDistanceFieldTest), false);
+
+		float MinRadius = 0.f;
+		float MaxRadius = MaxDistance;
+		for (int32 i = 0; i < ReferenceDistanceSteps; ++i)
+		{
+			const float Radius = (MinRadius + MaxRadius) * 0.5f;
+			if (World->OverlapBlockingTestByChannel(Location, FQuat::Identity, ECollisionChannel::ECC_Visibility, FCollisionShape::MakeSphere(Radius), QueryParams))
+			{
+				MaxRadius = Radius;
+			}
+			else
+			{
+				MinRadius = Radius;
+			}
+		}
+
+		return (MinRadius + MaxRadius) * 0.5f;
+	}
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDStaticDistanceFieldSphereQueryTest, "DungeonEscapeVR.Collision.StaticDistanceField.MatchesSphereQueries",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FDStaticDistanceFieldSphereQueryTest::RunTest(const FString& Parameters)
+{
+	DVRTest::FTestWorld TestWorld;
+	UWorld* World = TestWorld.GetWorld();
+
+	// Floor, a wall, a pillar and boxes rotated off the voxel grid, further apart than MaxDistance so each sample is nearest its own box
+	const FDistanceFieldTestBox Boxes[] =
+	{
+		{ FVector(0.f, 0.f, -10.f), FVector(400.f, 400.f, 10.f), FRotator::ZeroRotator },
+		{ FVector(0.f, 1000.f, 150.f), FVector(300.f, 10.f, 150.f), FRotator::ZeroRotator },
+		{ FVector(1000.f, 0.f, 150.f), FVector(25.f, 25.f, 150.f), FRotator::ZeroRotator },
+		{ FVector(1000.f, 1000.f, 100.f), FVector(80.f, 40.f, 60.f), FRotator(0.f, 33.f, 0.f) },
+		{ FVector(-1000.f, 0.f, 100.f), FVector(60.f, 60.f, 60.f), FRotator(20.f, 45.f, 10.f) },
+	};
+
+	for (const FDistanceFieldTestBox& Box : Boxes)
+	{
+		TestWorld.SpawnBox(Box.Center, Box.Extent, Box.Rotation, EComponentMobility::Static);
+	}
+
+	TArray<uint8> Data;
+	if (!TestTrue(TEXT("Distance field built"), FDStaticDistanceField::Build(World, DistanceFieldVoxelSize, DistanceFieldMaxDistance, Data))) return false;
+
+	// Loaded from file like at runtime, the file is memory mapped
+	const FString Filename = FPaths::AutomationTransientDir() / TEXT("StaticDistanceFieldTest.sdf");
+	if (!TestTrue(TEXT("Distance field saved"), FFileHelper::SaveArrayToFile(Data, *Filename))) return false;
+
+	FDStaticDistanceField DistanceField;
+	if (!TestTrue(TEXT("Distance field loaded"), DistanceField.Load(Filename)))
+	{
+		IFileManager::Get().Delete(*Filename);
+		return false;
+	}
+
+	// Sample near faces of every box, where camera fades, instead of uniformly in the bounds where most samples are at MaxDistance.
+	// Samples stay a voxel away from face edges, faces less than four voxels wide are not sampled
+	FRandomStream RandomStream(1400);
+	float MaxError = 0.f;
+	int32 NumErrors = 0;
+	int32 NumSamples = 0;
+
+	for (const FDistanceFieldTestBox& Box : Boxes)
+	{
+		const FTransform BoxTransform(Box.Rotation, Box.Center);
+		for (int32 i = 0; i < SamplesPerBox; ++i)
+		{
+			int32 Axis = RandomStream.RandRange(0, 2);
+			while (Box.Extent[(Axis + 1) % 3] < DistanceFieldVoxelSize * 2.f || Box.Extent[(Axis + 2) % 3] < DistanceFieldVoxelSize * 2.f)
+			{
+				Axis = RandomStream.RandRange(0, 2);
+			}
+			const float Side = RandomStream.FRand() < 0.5f ? -1.f : 1.f;
+
+			FVector LocalNormal = FVector::ZeroVector;
+			LocalNormal[Axis] = Side;
+
+			FVector LocalFacePoint;
+			for (int32 FaceAxis = 0; FaceAxis < 3; ++FaceAxis)
+			{
+				const float Range = Box.Extent[FaceAxis] - DistanceFieldVoxelSize;
+				LocalFacePoint[FaceAxis] = FaceAxis == Axis ? Side * Box.Extent[FaceAxis] : RandomStream.FRandRange(-Range, Range);
+			}
+
+			const float SurfaceDistance = RandomStream.FRandRange(MinSampleDistance, MaxSampleDistance);
+			const FVector Location = BoxTransform.TransformPosition(LocalFacePoint) + BoxTransform.TransformVectorNoScale(LocalNormal) * SurfaceDistance;
+
+			const float Distance = DistanceField.GetDistance(Location);
+			const float ReferenceDistance = GetReferenceDistance(World, Location, DistanceFieldMaxDistance);
+			const float Error = FMath::Abs(Distance - ReferenceDistance);
+
+			MaxError = FMath::Max(MaxError, Error);
+			++NumSamples;
+			if (Error > DistanceFieldTolerance)
+			{
+				AddError(FString::Printf(TEXT("Distance at %s is %.2f cm, sphere queries give %.2f cm"), *Location.ToString(), Distance, ReferenceDistance));
+				++NumErrors;
+			}
+		}
+	}
+
+	AddInfo(FString::Printf(TEXT("%d of %d samples within %.1f cm of sphere queries, largest error %.2f cm"), NumSamples - NumErrors, NumSamples, DistanceFieldTolerance, MaxError));
+
+	DistanceField.Unload();
+	IFileManager::Get().Delete(*Filename);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
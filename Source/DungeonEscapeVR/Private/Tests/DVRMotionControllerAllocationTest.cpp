@@ -0,0 +1,184 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Engine Includes
+#include "Engine/StaticMesh.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+#include "Materials/Material.h"
+
+
+// Game Includes
+#include "Player/DVRMotionController.h"
+#include "Tests/DVRTestUtils.h"
+
+
+namespace
+{
+	/** Forwards to the wrapped allocator, counting allocations made on the thread it was created on */
+	class FDVRCountingMalloc : public FMalloc
+	{
+	public:
+
+		explicit FDVRCountingMalloc(FMalloc* InInnerMalloc)
+			: InnerMalloc(InInnerMalloc)
+			, ThreadId(FPlatformTLS::GetCurrentThreadId())
+			, AllocationCount(0)
+		{
+		}
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation();
+			return InnerMalloc->Malloc(Count, Alignment);
+		}
+
+		virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation();
+			return InnerMalloc->TryMalloc(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			// Realloc to zero size frees
+			if (Count > 0)
+			{
+				CountAllocation();
+			}
+			return InnerMalloc->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			if (Count > 0)
+			{
+				CountAllocation();
+			}
+			return InnerMalloc->TryRealloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override { InnerMalloc->Free(Original); }
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return InnerMalloc->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return InnerMalloc->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { InnerMalloc->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { InnerMalloc->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { InnerMalloc->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual bool IsInternallyThreadSafe() const override { return InnerMalloc->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return InnerMalloc->ValidateHeap(); }
+		virtual const TCHAR* GetDescriptiveName() override { return InnerMalloc->GetDescriptiveName(); }
+
+		int32 GetAllocationCount() const { return AllocationCount; }
+
+	private:
+
+		void CountAllocation()
+		{
+			// Render and worker threads keep allocating while the game thread ticks the controller
+			if (FPlatformTLS::GetCurrentThreadId() == ThreadId)
+			{
+				++AllocationCount;
+			}
+		}
+
+		FMalloc* InnerMalloc;
+		uint32 ThreadId;
+		int32 AllocationCount;
+	};
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDVRMotionControllerTickAllocationTest, "DungeonEscapeVR.Player.MotionController.GameModeTickDoesNotAllocate",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FDVRMotionControllerTickAllocationTest::RunTest(const FString& Parameters)
+{
+	// One full aim sweep, see TickController
+	const int32 WarmUpTicks = 20;
+	const int32 MeasuredTicks = 100;
+	const float DeltaTime = 1.f / 90.f;
+
+	DVRTest::FTestWorld TestWorld;
+	UWorld* World = TestWorld.GetWorld();
+
+	// Floor for the teleport projectile path to hit, so the path is traced and drawn every tick
+	TestWorld.SpawnBox(FVector(0.f, 0.f, -5.f), FVector(5000.f, 5000.f, 5.f));
+
+	ADVRMotionController* MotionController = World->SpawnActor<ADVRMotionController>(FVector(0.f, 0.f, 150.f), FRotator::ZeroRotator);
+	if (!TestNotNull(TEXT("Motion controller spawned"), MotionController)) return false;
+
+	// Arc mesh is set on the Blueprint, without it UpdateTeleportArcMesh does nothing
+	MotionController->TeleportArchMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	MotionController->TeleportArchMaterial = UMaterial::GetDefaultMaterial(MD_Surface);
+	MotionController->InitTeleportArcMesh();
+
+	// Finer path sampling so arcs aimed high have more points than MaxTeleportArcSegments
+	MotionController->TeleportSimulationFrequency = 60.f;
+
+	MotionController->SetHand(EControllerHand::Left);
+	MotionController->SetControllerMode(EControllerMode::ECM_Game);
+	MotionController->StartFindTeleportDestination();
+
+	const ETeleportTraceMode TickModes[] = { ETeleportTraceMode::ETTM_Blocking, ETeleportTraceMode::ETTM_Broadphase };
+	for (const ETeleportTraceMode Mode : TickModes)
+	{
+		MotionController->TeleportTraceMode = Mode;
+
+		// Aim sweeps from the floor near the hand to 30 degrees up, path length and arc segment count change every tick
+		int32 MaxPathNum = 0;
+		int32 DrawnArcCount = 0;
+		auto TickController = [&](int32 Tick)
+		{
+			const float Pitch = -40.f + 70.f * (Tick % WarmUpTicks) / (WarmUpTicks - 1);
+			MotionController->SetActorRotation(FRotator(Pitch, 0.f, 0.f));
+			MotionController->Tick(DeltaTime);
+
+			// No navmesh in the test world, so every destination is invalid after the path is traced. Draw the traced path
+			// the way UpdateTeleportDestination does for a valid destination
+			const TArray<FVector>& Path = MotionController->TeleportPathBuffer;
+			if (Path.Num() > 1)
+			{
+				MotionController->TeleportDestinationMarker->SetWorldLocationAndRotation(Path.Last(), FRotator(0.f));
+				MotionController->ShowTeleportDestination(true);
+				MotionController->UpdateTeleportArcMesh(Path);
+			}
+			MaxPathNum = FMath::Max(MaxPathNum, Path.Num());
+			DrawnArcCount += MotionController->bTeleportArcVisible ? 1 : 0;
+		};
+
+		// Member buffers grow to their steady state size
+		for (int32 i = 0; i < WarmUpTicks; ++i)
+		{
+			TickController(i);
+		}
+
+		MaxPathNum = 0;
+		DrawnArcCount = 0;
+
+		FMalloc* PreviousMalloc = GMalloc;
+		FDVRCountingMalloc CountingMalloc(PreviousMalloc);
+		GMalloc = &CountingMalloc;
+
+		for (int32 i = 0; i < MeasuredTicks; ++i)
+		{
+			TickController(i);
+		}
+
+		GMalloc = PreviousMalloc;
+
+		const FString ModeName = UEnum::GetValueAsString(Mode);
+		TestEqual(FString::Printf(TEXT("Heap allocations over %d game mode ticks with %s"), MeasuredTicks, *ModeName), CountingMalloc.GetAllocationCount(), 0);
+
+		// Allocation count only means something if the path was traced and the arc drawn, including paths longer than the arc
+		TestEqual(FString::Printf(TEXT("Ticks with arc drawn with %s"), *ModeName), DrawnArcCount, MeasuredTicks);
+		TestTrue(FString::Printf(TEXT("Paths longer than MaxTeleportArcSegments with %s"), *ModeName), MaxPathNum - 1 > MotionController->MaxTeleportArcSegments);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,122 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Game Includes
+#include "Player/DVRPoseHistory.h"
+#include "Tests/DVRTestUtils.h"
+
+
+namespace
+{
+	/** Velocity estimation window used when releasing grabbed actors, see ADVRMotionController::ReleaseVelocityWindow */
+	const float ReleaseVelocityWindow = 0.1f;
+
+	/** Linear cm/s and angular rad/s error allowed, float precision of rotation vectors from quaternions limits the angular fit */
+	const float LinearVelocityTolerance = 0.1f;
+	const float AngularVelocityTolerance = 0.01f;
+
+	/**
+	 * Add NumPoses poses at Rate Hz, from StartTime onwards, moving from StartLocation and StartRotation with constant linear velocity
+	 * in cm/s and constant angular velocity in rad/s (world space axis * rate). Returns the time of the next pose
+	 */
+	double AddConstantVelocityPoses(FDVRPoseHistory& History, float Rate, int32 NumPoses, double StartTime, const FVector& StartLocation, const FQuat& StartRotation,
+		const FVector& LinearVelocity, const FVector& AngularVelocity, FVector& OutLocation, FQuat& OutRotation)
+	{
+		const double FrameTime = 1.0 / Rate;
+		const float AngularSpeed = AngularVelocity.Size();
+		const FVector AngularAxis = AngularVelocity.GetSafeNormal();
+
+		for (int32 i = 0; i < NumPoses; ++i)
+		{
+			const float T = static_cast<float>(i * FrameTime);
+			OutLocation = StartLocation + LinearVelocity * T;
+			OutRotation = AngularSpeed > 0.f ? FQuat(AngularAxis, AngularSpeed * T) * StartRotation : StartRotation;
+			History.AddPose(StartTime + i * FrameTime, OutLocation, OutRotation);
+		}
+
+		return StartTime + NumPoses * FrameTime;
+	}
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDVRPoseHistoryConstantVelocityTest, "DungeonEscapeVR.Player.PoseHistory.ConstantVelocity",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FDVRPoseHistoryConstantVelocityTest::RunTest(const FString& Parameters)
+{
+	const FVector LinearVelocity(150.f, -80.f, 40.f);
+	const FVector AngularVelocity(0.5f, -1.f, 2.f);
+	const FQuat StartRotation(FRotator(10.f, 45.f, -20.f));
+
+	for (const float Rate : DVRTest::FrameRates)
+	{
+		// Fewer poses than CAPACITY, only the poses inside the window are fit
+		FDVRPoseHistory History;
+		FVector Location;
+		FQuat Rotation;
+		AddConstantVelocityPoses(History, Rate, 20, 1000.0, FVector(10.f, 20.f, 100.f), StartRotation, LinearVelocity, AngularVelocity, Location, Rotation);
+
+		FVector EstimatedLinearVelocity;
+		FVector EstimatedAngularVelocity;
+		const bool bEstimated = History.EstimateVelocity(ReleaseVelocityWindow, EstimatedLinearVelocity, EstimatedAngularVelocity);
+
+		TestTrue(FString::Printf(TEXT("Velocity estimated at %.0f Hz"), Rate), bEstimated);
+		TestEqual(FString::Printf(TEXT("Linear velocity at %.0f Hz"), Rate), EstimatedLinearVelocity, LinearVelocity, LinearVelocityTolerance);
+		TestEqual(FString::Printf(TEXT("Angular velocity at %.0f Hz"), Rate), EstimatedAngularVelocity, AngularVelocity, AngularVelocityTolerance);
+	}
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDVRPoseHistoryRingBufferWrapTest, "DungeonEscapeVR.Player.PoseHistory.RingBufferWrap",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FDVRPoseHistoryRingBufferWrapTest::RunTest(const FString& Parameters)
+{
+	const FVector FirstLinearVelocity(-300.f, 50.f, 0.f);
+	const FVector FirstAngularVelocity(3.f, 0.f, 0.f);
+	const FVector LinearVelocity(120.f, 90.f, -30.f);
+	const FVector AngularVelocity(0.f, 0.5f, -1.5f);
+
+	// Second stream alone fills the buffer, a window covering every kept pose must only see the second velocity
+	const int32 FirstNumPoses = 40;
+	const int32 NumPoses = FDVRPoseHistory::CAPACITY + 8;
+	const float WholeHistoryWindow = 10.f;
+
+	for (const float Rate : DVRTest::FrameRates)
+	{
+		FDVRPoseHistory History;
+		FVector FirstEndLocation;
+		FQuat FirstEndRotation;
+		const double SecondStartTime = AddConstantVelocityPoses(History, Rate, FirstNumPoses, 1000.0, FVector::ZeroVector, FQuat::Identity,
+			FirstLinearVelocity, FirstAngularVelocity, FirstEndLocation, FirstEndRotation);
+
+		FVector Location;
+		FQuat Rotation;
+		AddConstantVelocityPoses(History, Rate, NumPoses, SecondStartTime, FirstEndLocation, FirstEndRotation, LinearVelocity, AngularVelocity, Location, Rotation);
+
+		TestEqual(FString::Printf(TEXT("Pose count at %.0f Hz"), Rate), History.Num(), FDVRPoseHistory::CAPACITY);
+
+		FVector EstimatedLinearVelocity;
+		FVector EstimatedAngularVelocity;
+		const bool bEstimated = History.EstimateVelocity(WholeHistoryWindow, EstimatedLinearVelocity, EstimatedAngularVelocity);
+
+		TestTrue(FString::Printf(TEXT("Velocity estimated after wrap at %.0f Hz"), Rate), bEstimated);
+		TestEqual(FString::Printf(TEXT("Linear velocity after wrap at %.0f Hz"), Rate), EstimatedLinearVelocity, LinearVelocity, LinearVelocityTolerance);
+		TestEqual(FString::Printf(TEXT("Angular velocity after wrap at %.0f Hz"), Rate), EstimatedAngularVelocity, AngularVelocity, AngularVelocityTolerance);
+
+		// Short window after wrap, at higher rates the poses in it straddle the end of the pose array
+		History.EstimateVelocity(ReleaseVelocityWindow, EstimatedLinearVelocity, EstimatedAngularVelocity);
+		TestEqual(FString::Printf(TEXT("Linear velocity in window after wrap at %.0f Hz"), Rate), EstimatedLinearVelocity, LinearVelocity, LinearVelocityTolerance);
+		TestEqual(FString::Printf(TEXT("Angular velocity in window after wrap at %.0f Hz"), Rate), EstimatedAngularVelocity, AngularVelocity, AngularVelocityTolerance);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,151 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Engine Includes
+#include "Engine/World.h"
+#include "Math/RandomStream.h"
+#include "Misc/App.h"
+
+
+// Game Includes
+#include "Player/DVRPlayerCharacter.h"
+#include "Tests/DVRTestUtils.h"
+
+
+namespace
+{
+	/** Head motion streams relocated from per frame rate */
+	const int32 RelocationStreamCount = 200;
+
+	/** Frames of HMD poses tracked before each relocation */
+	const int32 RelocationHistoryFrames = 30;
+
+	/** Horizontal cm the rendered HMD may land from the target, and how much smaller than placing from the sampled HMD location the mean error must be */
+	const float MaxPredictedError = 1.f;
+	const float MaxPredictedToSampledErrorRatio = 0.25f;
+
+	/** Measured error is interpolated from tracked poses, tracking noise and sway between frames put it this far from the true error */
+	const float RelocationErrorMeasureTolerance = 0.15f;
+
+	struct FRelocationResult
+	{
+		/** Horizontal cm between the target and the HMD rendered at the late update */
+		float RenderedError;
+
+		/** ADVRPlayerCharacter::LastRelocationError measured the frame after */
+		float MeasuredError;
+		bool bMeasured;
+	};
+
+	/**
+	 * Track Stream for RelocationHistoryFrames at Rate Hz, then snap turn or teleport to a random target with the relocation path of the
+	 * character, rendered at a random late update gap within the frame. Random values are drawn from RandomStream
+	 */
+	FRelocationResult RunRelocation(ADVRPlayerCharacter* Character, float Rate, FRandomStream& RandomStream)
+	{
+		const DVRTest::FHeadMotionStream Stream(RandomStream);
+		const float FrameTime = 1.f / Rate;
+		const double StartTime = 1000.0;
+
+		Character->HMDPoseHistory.Reset();
+
+		for (int32 Frame = 0; Frame < RelocationHistoryFrames; ++Frame)
+		{
+			FApp::SetCurrentTime(StartTime + Frame * FrameTime);
+			Character->HMDLocationOverride = Stream.GetTrackedLocation(Frame * FrameTime, RandomStream);
+			Character->UpdateHMDPoseHistory();
+		}
+
+		// Relocated on the last tracked frame, from input or a timer after the tick sampled the HMD
+		const float RelocationTime = (RelocationHistoryFrames - 1) * FrameTime;
+		const float LateUpdateGap = RandomStream.FRandRange(0.25f, 0.75f) * FrameTime;
+		Character->LateUpdateGapOverride = LateUpdateGap;
+		Character->HMDLocationOverride = Stream.GetTrackedLocation(RelocationTime, RandomStream);
+
+		const FVector TargetLocation(RandomStream.FRandRange(-1000.f, 1000.f), RandomStream.FRandRange(-1000.f, 1000.f), 0.f);
+		const FRotator NewRotation(0.f, RandomStream.FRandRange(-180.f, 180.f), 0.f);
+		const float NewHeight = RandomStream.FRandRange(-100.f, 100.f);
+
+		const FVector HMDLocation = Character->SampleRelocationHMDLocation();
+		Character->RelocateVRCenter(TargetLocation, HMDLocation, NewRotation, NewHeight, ETeleportType::TeleportPhysics);
+
+		FRelocationResult Result;
+		const FVector RenderedHMDLocation = Character->VRCenter->GetComponentTransform().TransformPosition(Stream.GetLocation(RelocationTime + LateUpdateGap));
+		Result.RenderedError = FVector::DistXY(RenderedHMDLocation, TargetLocation);
+
+		// Next frame's tick measures the error of the relocation
+		FApp::SetCurrentTime(StartTime + RelocationHistoryFrames * FrameTime);
+		Character->HMDLocationOverride = Stream.GetTrackedLocation(RelocationHistoryFrames * FrameTime, RandomStream);
+		Character->UpdateHMDPoseHistory();
+
+		Result.bMeasured = !Character->bMeasureRelocationError;
+		Result.MeasuredError = Character->LastRelocationError;
+		return Result;
+	}
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDVRRelocationPredictionTest, "DungeonEscapeVR.Player.RelocationPrediction",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FDVRRelocationPredictionTest::RunTest(const FString& Parameters)
+{
+	DVRTest::FTestWorld TestWorld;
+
+	ADVRPlayerCharacter* Character = TestWorld.GetWorld()->SpawnActor<ADVRPlayerCharacter>();
+	if (!TestNotNull(TEXT("Player character spawned"), Character)) return false;
+
+	// Relocations are driven with simulated frame times
+	const double CurrentTime = FApp::GetCurrentTime();
+
+	for (const float Rate : DVRTest::FrameRates)
+	{
+		float SampledErrorSum = 0.f;
+		float PredictedErrorSum = 0.f;
+		float PredictedErrorMax = 0.f;
+		float MeasureErrorMax = 0.f;
+
+		for (int32 StreamIndex = 0; StreamIndex < RelocationStreamCount; ++StreamIndex)
+		{
+			// Same seed for both runs, so they replay the same stream, noise and target
+			FRandomStream RandomStream(1337 + StreamIndex);
+
+			Character->bPredictHMDLocationOnRelocation = false;
+			const FRelocationResult Sampled = RunRelocation(Character, Rate, RandomStream);
+
+			RandomStream.Reset();
+			Character->bPredictHMDLocationOnRelocation = true;
+			const FRelocationResult Predicted = RunRelocation(Character, Rate, RandomStream);
+
+			SampledErrorSum += Sampled.RenderedError;
+			PredictedErrorSum += Predicted.RenderedError;
+			PredictedErrorMax = FMath::Max(PredictedErrorMax, Predicted.RenderedError);
+
+			for (const FRelocationResult& Result : { Sampled, Predicted })
+			{
+				if (!TestTrue(FString::Printf(TEXT("Relocation error measured the frame after at %.0f Hz"), Rate), Result.bMeasured)) continue;
+				MeasureErrorMax = FMath::Max(MeasureErrorMax, FMath::Abs(Result.MeasuredError - Result.RenderedError));
+			}
+		}
+
+		const float SampledErrorMean = SampledErrorSum / RelocationStreamCount;
+		const float PredictedErrorMean = PredictedErrorSum / RelocationStreamCount;
+
+		AddInfo(FString::Printf(TEXT("%.0f Hz relocation error: sampled %.3f cm mean, predicted %.3f cm mean %.3f cm max, measured within %.3f cm"),
+			Rate, SampledErrorMean, PredictedErrorMean, PredictedErrorMax, MeasureErrorMax));
+
+		TestTrue(FString::Printf(TEXT("Predicted relocation error at %.0f Hz within %.1f cm"), Rate, MaxPredictedError), PredictedErrorMax <= MaxPredictedError);
+		TestTrue(FString::Printf(TEXT("Predicted relocation error at %.0f Hz smaller than sampled"), Rate), PredictedErrorMean <= SampledErrorMean * MaxPredictedToSampledErrorRatio);
+		TestTrue(FString::Printf(TEXT("Measured relocation error at %.0f Hz matches rendered error"), Rate), MeasureErrorMax <= RelocationErrorMeasureTolerance);
+	}
+
+	FApp::SetCurrentTime(CurrentTime);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,137 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Engine Includes
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+
+// Game Includes
+#include "Player/DVRMotionController.h"
+#include "Tests/DVRTestUtils.h"
+
+
+namespace
+{
+	/** Controller poses searched from, each search mode uses the same poses */
+	const int32 TeleportBenchmarkPoseCount = 500;
+
+	/** Hit locations of both modes must agree, both sweep the same projectile path */
+	const float TeleportHitLocationTolerance = 1.f;
+
+	struct FTeleportBenchmarkPose
+	{
+		FVector Location;
+		FRotator Rotation;
+	};
+
+	/** Dungeon sized room, 20 m square with 4 m high walls, with seeded pillars and crates the teleport arc can hit or pass over */
+	void SpawnTeleportBenchmarkRoom(const DVRTest::FTestWorld& TestWorld, FRandomStream& RandomStream)
+	{
+		TestWorld.SpawnBox(FVector(0.f, 0.f, -5.f), FVector(1000.f, 1000.f, 5.f));
+		TestWorld.SpawnBox(FVector(1000.f, 0.f, 200.f), FVector(10.f, 1000.f, 200.f));
+		TestWorld.SpawnBox(FVector(-1000.f, 0.f, 200.f), FVector(10.f, 1000.f, 200.f));
+		TestWorld.SpawnBox(FVector(0.f, 1000.f, 200.f), FVector(1000.f, 10.f, 200.f));
+		TestWorld.SpawnBox(FVector(0.f, -1000.f, 200.f), FVector(1000.f, 10.f, 200.f));
+
+		for (int32 i = 0; i < 12; ++i)
+		{
+			const FVector Location(RandomStream.FRandRange(-900.f, 900.f), RandomStream.FRandRange(-900.f, 900.f), 0.f);
+			const bool bPillar = RandomStream.FRand() < 0.5f;
+			const FVector Extent = bPillar ? FVector(25.f, 25.f, 200.f) : FVector(RandomStream.FRandRange(30.f, 80.f), RandomStream.FRandRange(30.f, 80.f), RandomStream.FRandRange(20.f, 60.f));
+			TestWorld.SpawnBox(Location + FVector(0.f, 0.f, Extent.Z), Extent, FRotator(0.f, RandomStream.FRandRange(0.f, 90.f), 0.f));
+		}
+	}
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDVRTeleportTraceBenchmarkTest, "DungeonEscapeVR.Player.MotionController.TeleportTraceBenchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FDVRTeleportTraceBenchmarkTest::RunTest(const FString& Parameters)
+{
+	DVRTest::FTestWorld TestWorld;
+	UWorld* World = TestWorld.GetWorld();
+
+	FRandomStream RandomStream(2002);
+	SpawnTeleportBenchmarkRoom(TestWorld, RandomStream);
+
+	ADVRMotionController* MotionController = World->SpawnActor<ADVRMotionController>();
+	if (!TestNotNull(TEXT("Motion controller spawned"), MotionController)) return false;
+
+	MotionController->SetHand(EControllerHand::Left);
+
+	// Hand height of a standing player, aiming from below the horizon (short arcs onto the floor) to well above it (arcs into walls and pillars)
+	TArray<FTeleportBenchmarkPose> Poses;
+	Poses.Reserve(TeleportBenchmarkPoseCount);
+	for (int32 i = 0; i < TeleportBenchmarkPoseCount; ++i)
+	{
+		FTeleportBenchmarkPose& Pose = Poses.AddDefaulted_GetRef();
+		Pose.Location = FVector(RandomStream.FRandRange(-900.f, 900.f), RandomStream.FRandRange(-900.f, 900.f), RandomStream.FRandRange(80.f, 160.f));
+		Pose.Rotation = FRotator(RandomStream.FRandRange(-60.f, 45.f), RandomStream.FRandRange(-180.f, 180.f), RandomStream.FRandRange(-30.f, 30.f));
+	}
+
+	const ETeleportTraceMode BenchmarkModes[] = { ETeleportTraceMode::ETTM_Blocking, ETeleportTraceMode::ETTM_Broadphase };
+	TArray<bool> HitsByMode[UE_ARRAY_COUNT(BenchmarkModes)];
+	TArray<FVector> HitLocationsByMode[UE_ARRAY_COUNT(BenchmarkModes)];
+
+	TArray<FVector> Path;
+	for (int32 ModeIndex = 0; ModeIndex < UE_ARRAY_COUNT(BenchmarkModes); ++ModeIndex)
+	{
+		const ETeleportTraceMode Mode = BenchmarkModes[ModeIndex];
+		HitsByMode[ModeIndex].Reserve(Poses.Num());
+		HitLocationsByMode[ModeIndex].Reserve(Poses.Num());
+
+		MotionController->TeleportTraceQueryCount = 0;
+		double SearchSeconds = 0.0;
+
+		for (const FTeleportBenchmarkPose& Pose : Poses)
+		{
+			MotionController->SetActorLocationAndRotation(Pose.Location, Pose.Rotation);
+
+			// Only the search is timed, moving the controller updates its components and overlaps
+			Path.Reset();
+			FVector Location;
+			const double StartTime = FPlatformTime::Seconds();
+			if (Mode == ETeleportTraceMode::ETTM_Blocking)
+			{
+				MotionController->FindTeleportDestination(Path, Location);
+			}
+			else
+			{
+				MotionController->FindTeleportDestinationBroadphase(Path, Location);
+			}
+			SearchSeconds += FPlatformTime::Seconds() - StartTime;
+
+			// No navmesh in the test world, so compare the path hits instead of the projected destinations
+			const FPoseGatedTraceCache& TraceCache = MotionController->TeleportPathTraceCache;
+			HitsByMode[ModeIndex].Add(TraceCache.bValid);
+			HitLocationsByMode[ModeIndex].Add(TraceCache.HitLocation);
+		}
+
+		AddInfo(FString::Printf(TEXT("Teleport trace %s: %.4f ms, %.1f scene queries per search over %d poses"), *UEnum::GetValueAsString(Mode),
+			SearchSeconds * 1000.0 / Poses.Num(), static_cast<float>(MotionController->TeleportTraceQueryCount) / Poses.Num(), Poses.Num()));
+	}
+
+	int32 HitCount = 0;
+	for (int32 i = 0; i < Poses.Num(); ++i)
+	{
+		HitCount += HitsByMode[0][i] ? 1 : 0;
+		if (!TestEqual(FString::Printf(TEXT("Both modes hit from pose %d"), i), HitsByMode[1][i], HitsByMode[0][i])) continue;
+		if (HitsByMode[0][i])
+		{
+			TestEqual(FString::Printf(TEXT("Hit location from pose %d"), i), HitLocationsByMode[1][i], HitLocationsByMode[0][i], TeleportHitLocationTolerance);
+		}
+	}
+
+	// Poses aimed high may leave the room within the simulation time, most must hit something
+	TestTrue(FString::Printf(TEXT("Most poses hit the room (%d/%d)"), HitCount, Poses.Num()), HitCount > Poses.Num() / 2);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
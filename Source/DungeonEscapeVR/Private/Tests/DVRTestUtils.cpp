@@ -0,0 +1,83 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Tests/DVRTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Engine Includes
+#include "Components/StaticMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Math/RandomStream.h"
+
+
+namespace DVRTest
+{
+	FTestWorld::FTestWorld()
+	{
+		World = UWorld::CreateWorld(EWorldType::Game, false);
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		WorldContext.SetCurrentWorld(World);
+		World->InitializeActorsForPlay(FURL());
+		World->BeginPlay();
+	}
+
+
+	FTestWorld::~FTestWorld()
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+
+
+	AStaticMeshActor* FTestWorld::SpawnBox(const FVector& Center, const FVector& Extent, const FRotator& Rotation, EComponentMobility::Type Mobility) const
+	{
+		static UStaticMesh* CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+
+		AStaticMeshActor* Box = World->SpawnActor<AStaticMeshActor>(Center, Rotation);
+		if (Box)
+		{
+			// Static mesh actors spawn with static mobility, which does not allow changing mesh or transform during play
+			Box->SetMobility(EComponentMobility::Movable);
+			Box->GetStaticMeshComponent()->SetStaticMesh(CubeMesh);
+			Box->GetStaticMeshComponent()->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+
+			// Engine cube is 100 cm across
+			Box->SetActorScale3D(Extent / 50.f);
+
+			if (Mobility != EComponentMobility::Movable)
+			{
+				Box->SetMobility(Mobility);
+				Box->GetStaticMeshComponent()->RecreatePhysicsState();
+			}
+		}
+
+		return Box;
+	}
+
+
+	FHeadMotionStream::FHeadMotionStream(FRandomStream& RandomStream)
+	{
+		Velocity = FVector(RandomStream.FRandRange(-1.f, 1.f), RandomStream.FRandRange(-1.f, 1.f), 0.f).GetSafeNormal() * RandomStream.FRandRange(0.f, 150.f);
+		SwayAmplitude = RandomStream.GetUnitVector() * RandomStream.FRandRange(0.f, 5.f);
+		SwayFrequency = RandomStream.FRandRange(0.5f, 2.f);
+		SwayPhase = RandomStream.FRandRange(0.f, 2.f * PI);
+	}
+
+
+	FVector FHeadMotionStream::GetLocation(float Time) const
+	{
+		return FVector(0.f, 0.f, 170.f) + Velocity * Time + SwayAmplitude * FMath::Sin(2.f * PI * SwayFrequency * Time + SwayPhase);
+	}
+
+
+	FVector FHeadMotionStream::GetTrackedLocation(float Time, FRandomStream& RandomStream) const
+	{
+		return GetLocation(Time) + RandomStream.GetUnitVector() * 0.05f;
+	}
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
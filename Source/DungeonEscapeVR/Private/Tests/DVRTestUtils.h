@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Engine/EngineTypes.h"
+
+
+/** Forward declarations */
+class UWorld;
+class AStaticMeshActor;
+struct FRandomStream;
+
+
+namespace DVRTest
+{
+	/** Frame rates of reprojection (45 Hz) and native refresh rates of common headsets */
+	constexpr float FrameRates[] = { 45.f, 72.f, 90.f, 120.f };
+
+	/**
+	 * Seeded head motion in tracking space, walking up to 1.5 m/s with up to 5 cm of sway at 0.5 - 2 Hz. Tracked locations
+	 * have 0.05 cm of tracking noise
+	 */
+	struct FHeadMotionStream
+	{
+		explicit FHeadMotionStream(FRandomStream& RandomStream);
+
+		/** Head location at Time in seconds */
+		FVector GetLocation(float Time) const;
+
+		/** Head location at Time with tracking noise drawn from RandomStream */
+		FVector GetTrackedLocation(float Time, FRandomStream& RandomStream) const;
+
+	private:
+
+		FVector Velocity;
+		FVector SwayAmplitude;
+		float SwayFrequency;
+		float SwayPhase;
+	};
+
+	/**
+	 * Game world for automation tests, play has begun when constructed. Destroyed with the fixture
+	 */
+	class FTestWorld
+	{
+	public:
+
+		FTestWorld();
+		~FTestWorld();
+
+		UWorld* GetWorld() const { return World; }
+
+		/** Spawn a box blocking all channels. Extent is half the box size in cm */
+		AStaticMeshActor* SpawnBox(const FVector& Center, const FVector& Extent, const FRotator& Rotation = FRotator::ZeroRotator,
+			EComponentMobility::Type Mobility = EComponentMobility::Movable) const;
+
+	private:
+
+		UWorld* World;
+	};
+
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,42 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "DBuildDistanceFieldCommandlet.generated.h"
+
+
+/** Forward Declarations */
+class FDStaticDistanceField;
+
+
+/**
+ * Bakes FDStaticDistanceField files for maps in /Game/DungeonEscapeVR/Maps. Rerun after changing static level collision.
+ *
+ *	UE4Editor-Cmd.exe DungeonEscapeVR.uproject -run=DBuildDistanceField [-Maps=Dungeon_Escape_L1] [-VoxelSize=10] [-MaxDistance=60] [-Validate] [-ValidationSamples=10000]
+ *
+ * -Maps is a map name prefix. -Validate compares each baked field against sphere overlap tests of the physics scene at random locations and
+ * fails the commandlet if any distance is outside the expected error
+ */
+UCLASS()
+class DUNGEONESCAPEVR_API UDBuildDistanceFieldCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+
+public:
+
+	UDBuildDistanceFieldCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+
+private:
+
+#if WITH_EDITOR
+	/** Check DistanceField against static collision in World at NumSamples random locations. Returns false if any sample is off by more than a voxel */
+	bool ValidateDistanceField(UWorld* World, const FDStaticDistanceField& DistanceField, int32 NumSamples) const;
+#endif
+
+};
@@ -0,0 +1,97 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+/** Forward Declarations */
+class IMappedFileHandle;
+class IMappedFileRegion;
+class UWorld;
+
+
+/** File header of a baked static distance field, followed by brick index table and brick samples. See FDStaticDistanceField */
+struct FDStaticDistanceFieldHeader
+{
+	uint32 Magic;
+	uint32 Version;
+
+	/** World location of the first sample of brick 0, 0, 0 */
+	FVector Origin;
+
+	/** Distance in cm between samples */
+	float VoxelSize;
+
+	/** Distances are clamped to MaxDistance, locations further from static collision return MaxDistance */
+	float MaxDistance;
+
+	/** Number of bricks along each axis of the brick index table */
+	FIntVector BrickCount;
+
+	/** Number of bricks with samples stored */
+	int32 NumBricks;
+};
+
+
+/**
+ * Sparse distance field of a map's static collision, baked offline by UDBuildDistanceFieldCommandlet and memory mapped at runtime.
+ * The world is split into bricks of BRICK_SAMPLES^3 quantized distance samples. Only bricks within MaxDistance of static collision store
+ * samples, every other location is at least MaxDistance from static collision. Looking up a distance is constant time and runs no physics query.
+ * Distances inside collision are 0
+ */
+class DUNGEONESCAPEVR_API FDStaticDistanceField
+{
+
+public:
+
+	/** Samples along each axis of a brick. Neighbouring bricks share border samples so a brick can always be sampled trilinearly */
+	static constexpr int32 BRICK_SAMPLES = 8;
+	static constexpr int32 BRICK_CELLS = BRICK_SAMPLES - 1;
+	static constexpr int32 BRICK_SAMPLE_COUNT = BRICK_SAMPLES * BRICK_SAMPLES * BRICK_SAMPLES;
+
+	static constexpr uint32 FILE_MAGIC = 0x46445344; // 'DSDF'
+	static constexpr uint32 FILE_VERSION = 1;
+
+	FDStaticDistanceField();
+	~FDStaticDistanceField();
+
+	/** Memory map baked distance field file. Returns false if the file does not exist or is not a valid distance field */
+	bool Load(const FString& Filename);
+
+	/** Unmap loaded distance field */
+	void Unload();
+
+	bool IsLoaded() const { return Header != nullptr; }
+
+	/** Distance in cm from Location to the nearest static collision, clamped to GetMaxDistance(). Returns MAX_FLT if not loaded */
+	float GetDistance(const FVector& Location) const;
+
+	float GetMaxDistance() const { return Header ? Header->MaxDistance : 0.f; }
+	float GetVoxelSize() const { return Header ? Header->VoxelSize : 0.f; }
+
+	/** World bounds covered by brick index table */
+	FBox GetBounds() const;
+
+	/** Baked distance field file of map MapName, e.g. Dungeon_Escape_L1_2 */
+	static FString GetFilename(const FString& MapName);
+
+#if WITH_EDITOR
+	/**
+	 * Bake distance field of World's static collision that blocks ECC_Visibility, the channel camera collision is swept on.
+	 * OutData is the file contents to save to GetFilename()
+	 */
+	static bool Build(UWorld* World, float VoxelSize, float MaxDistance, TArray<uint8>& OutData);
+#endif
+
+
+private:
+
+	TUniquePtr<IMappedFileHandle> MappedFileHandle;
+	TUniquePtr<IMappedFileRegion> MappedFileRegion;
+
+	/** Pointers into mapped file */
+	const FDStaticDistanceFieldHeader* Header;
+	const int32* BrickIndices;
+	const uint8* BrickSamples;
+};
@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Collision/DStaticDistanceField.h"
+#include "DStaticDistanceFieldSubsystem.generated.h"
+
+
+/**
+ * Loads the baked static distance field of the current map, if one was built with UDBuildDistanceFieldCommandlet. Lets gameplay ask how far a
+ * location is from static level collision without a physics query
+ */
+UCLASS()
+class DUNGEONESCAPEVR_API UDStaticDistanceFieldSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+
+public:
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** True if a baked distance field was loaded for this world's map */
+	bool HasDistanceField() const { return DistanceField.IsLoaded(); }
+
+	/** Distance in cm from Location to nearest static collision, clamped to distance field max distance. Only valid if HasDistanceField() */
+	float GetDistanceToStaticCollision(const FVector& Location) const { return DistanceField.GetDistance(Location); }
+
+
+private:
+
+	FDStaticDistanceField DistanceField;
+
+};
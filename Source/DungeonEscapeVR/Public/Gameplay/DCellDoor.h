@@ -12,6 +12,7 @@ class ADCellDoorTrigger;
 class UStaticMeshComponent;
 class UBoxComponent;
 class UParticleSystem;
+class UCurveFloat;
 
 
 /**
@@ -33,7 +34,8 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnCellDoorStateChange, AActor*, Ce
 
 /**
  * Base class for cell doors. Cell doors will prevent player from passing until weight on the cell door triggers exceeds weight limit.
- * The process of opening and closing cell doors is driven via time line in derived blueprint. VFX and SFX are spawned in derived blueprint.
+ * Opening and closing is driven by OpenCellDoorCurve and CloseCellDoorCurve through UDCellDoorMotionSubsystem, or via time line in derived
+ * blueprint when the curves are not set. VFX and SFX are spawned in derived blueprint.
  */
 UCLASS()
 class DUNGEONESCAPEVR_API ADCellDoor : public AActor
@@ -48,18 +50,31 @@ public:
 	/** Delegate for Cell door state change */
 	FOnCellDoorStateChange OnCellDoorStateChange;
 
-	/* Called every frame */
-	virtual void Tick(float DeltaTime) override;
-
 	/** Return mass of all physics actors placed on all instances of ADCellDoorTrigger stored in CellDoorTriggers */
 	float CalculateTotalWeightOnTriggers() const;
 
+	/**
+	 * Advance the active open or close curve by DeltaTime and move the cell door. Called by UDCellDoorMotionSubsystem
+	 * @returns true while the cell door is still moving
+	 */
+	bool UpdateCellDoorMotion(float DeltaTime);
+
+	/** Active curve reached its end, calls OnFinishCellDoorOpened() or OnFinishedCellDoorClosed(). Called by UDCellDoorMotionSubsystem */
+	void FinishCellDoorMotion();
+
 
 protected:
 
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+#if WITH_EDITOR
+	/** Cell doors do not tick, re-evaluate open/close state when bDebugForceGateOpen is toggled during play */
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 
 private:
 
@@ -92,6 +107,14 @@ private:
 	UPROPERTY(EditAnywhere, Category = "Config")
 	float WeightToOpenCell;
 
+	/** Cell door height offset over time while opening. When not set BP_OpenCellDoor() drives the cell door */
+	UPROPERTY(EditAnywhere, Category = "Config|Motion")
+	UCurveFloat* OpenCellDoorCurve;
+
+	/** Cell door height offset over time while closing. When not set BP_CloseCellDoor() drives the cell door */
+	UPROPERTY(EditAnywhere, Category = "Config|Motion")
+	UCurveFloat* CloseCellDoorCurve;
+
 
 	/*******************************************************************/
 	/* State */
@@ -105,14 +128,33 @@ private:
 	UPROPERTY(VisibleAnywhere, Category = "State")
 	ECellDoorState CellDoorState;
 
-	/** Check the current weight on all triggers and current CellDoorState. Calls functions to Open/Close cell door if conditions are met */
+	/** OpenCellDoorCurve or CloseCellDoorCurve while moved by UDCellDoorMotionSubsystem */
+	UPROPERTY()
+	UCurveFloat* ActiveMotionCurve;
+
+	/** Time into ActiveMotionCurve */
+	float MotionTime;
+
+	/** Move with ActiveMotionCurve through UDCellDoorMotionSubsystem. Returns false if the subsystem is not available */
+	bool StartCellDoorMotion(UCurveFloat* MotionCurve);
+
+	/** Set cell door height offset from InitialCellDoorHeight */
+	void SetCellDoorHeightOffset(float CellDoorHeightOffset);
+
+	/**
+	 * Check the current weight on all triggers and current CellDoorState. Calls functions to Open/Close cell door if conditions are met.
+	 * Called when weight on a trigger changes and when the door finishes opening or closing, cell doors do not tick
+	 */
 	void ProcessDoorOpenCloseState();
 
+	/** Bound to OnWeightChanged of each of CellDoorTriggers */
+	void OnTriggerWeightChanged(ADCellDoorTrigger* CellDoorTrigger);
+
 	/**
 	 * Start process of opening cell door. This function is called internally when the weight on all CellDoorTriggeres exceeds WeightToOpenCell. 
 	 * CellDoorBlockingCollision will not remain blocking until cell door is completely open. OnCellDoorStateChange will broadcast event when blocking collision is removed.
 	 * 
-	 * @note cell door movement is driven from Timeline in derived Blueprint class.
+	 * @note cell door movement is driven by OpenCellDoorCurve, or from Timeline in derived Blueprint class when not set.
 	 * @see BP_OpenCellDoor
 	 */
 	void OpenCellDoor();
@@ -121,23 +163,26 @@ private:
 	 * Start process of closing cell door. This function is called internally when the weight on all CellDoorTriggeres is less than WeightToOpenCell.
 	 * CellDoorBlockingCollision will start blocking when this function is called. Therefor blocking collisions may be made before visual state of cell door indicated the cell door is closed
 	 *  
-	 * @note cell door movement is driven from Timeline in derived Blueprint class.
+	 * @note cell door movement is driven by CloseCellDoorCurve, or from Timeline in derived Blueprint class when not set.
 	 * @see BP_CloseCellDoor
 	 */
 	void CloseCellDoor();
 
 
 	/**************************************************************************************************/
-	/* Cell Door Open/Close. These functions should be called from derived blueprint via timeline */
+	/* Cell Door Open/Close. These functions should be called from derived blueprint via timeline when no motion curves are set */
 	/*************************************************************************************************/
 
 protected:
 
-	/** Blueprint event for opening cell door. As cell door opens OnUpdateCellDoorHeight() and OnFinishCellDoorOpened() will be called in derived blueprint */
+	/**
+	 * Blueprint event for opening cell door when OpenCellDoorCurve is not set. As cell door opens OnUpdateCellDoorHeight() and OnFinishCellDoorOpened()
+	 * will be called in derived blueprint. Use OnCellDoorStateChange for VFX and SFX when curves are set
+	 */
 	UFUNCTION(BlueprintImplementableEvent, Category = "CellDoorState")
 	void BP_OpenCellDoor();
 
-	/** Blueprint event for opening cell door. As cell door closes OnUpdateCellDoorHeight() and OnFinishedCellDoorClosed() will be called in derived blueprint */
+	/** Blueprint event for closing cell door when CloseCellDoorCurve is not set. As cell door closes OnUpdateCellDoorHeight() and OnFinishedCellDoorClosed() will be called in derived blueprint */
 	UFUNCTION(BlueprintImplementableEvent, Category = "CellDoorState")
 	void BP_CloseCellDoor();
 
@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "DCellDoorMotionSubsystem.generated.h"
+
+
+/** Forward Declarations */
+class ADCellDoor;
+
+
+/**
+ * Moves all opening and closing ADCellDoors in one update per frame. Doors with open and close curves add themselves when they start moving,
+ * each tick evaluates every moving door's curve natively. Finish callbacks are made after all doors are moved, so a door that starts moving
+ * again from its finish callback is picked up next frame
+ */
+UCLASS()
+class DUNGEONESCAPEVR_API UDCellDoorMotionSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+
+public:
+
+	/** Move CellDoor each tick until ADCellDoor::UpdateCellDoorMotion() reports the motion finished */
+	void AddMovingCellDoor(ADCellDoor* CellDoor);
+
+	/** Stop moving CellDoor without finishing its motion, e.g. on EndPlay */
+	void RemoveMovingCellDoor(ADCellDoor* CellDoor);
+
+	/** FTickableGameObject */
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override { return MovingCellDoors.Num() > 0; }
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+	virtual TStatId GetStatId() const override;
+
+
+private:
+
+	/*******************************************************************/
+	/* State */
+	/*******************************************************************/
+
+	TArray<TWeakObjectPtr<ADCellDoor>> MovingCellDoors;
+
+};
@@ -11,6 +11,11 @@
 class UBoxComponent;
 class UStaticMeshComponent;
 class ADInteractableActor;
+class ADCellDoorTrigger;
+
+
+/** Declare delegate for weight on trigger change */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnTriggerWeightChanged, ADCellDoorTrigger* /* CellDoorTrigger */);
 
 
 /**
@@ -27,10 +32,14 @@ public:
 	ADCellDoorTrigger();
 
 	/**
-	 * Get the total wight of all cell door keys placed on trigger, this is the weight of all elements of CellDoorKeys.
-	 * @returns Combined mass of all ADInteractableActors UPrimitiveComponent in CellDoorKeys
+	 * Get the total wight of all cell door keys placed on trigger, this is the weight of all elements of CellDoorKeys not picked up.
+	 * Kept up to date as keys are placed, removed, picked up and released
+	 * @returns Combined Weight of ADInteractableActors in CellDoorKeys
 	 */
-	float GetWeightOnTrigger() const;
+	float GetWeightOnTrigger() const { return WeightOnTrigger; }
+
+	/** Broadcast when a key is placed on or removed from trigger, or a key on trigger is picked up or released. See ADCellDoor */
+	FOnTriggerWeightChanged OnWeightChanged;
 
 
 protected:
@@ -54,37 +63,36 @@ private:
 
 	/**
 	 * Used to determine CellDoorKeys currently placed on trigger. Overlapping ADInteractableActors
-	 * with tag matching CellDoorKeyTag will be stored in CellDoorKeys
+	 * flagged as cell door key will be stored in CellDoorKeys. See ADInteractableActor::IsCellDoorKey()
 	 */
 	UPROPERTY(EditDefaultsOnly, Category = "Components")
 	UBoxComponent* BoxComp;
 
 
-	/*******************************************************************/
-	/* Config */
-	/*******************************************************************/
-
-	UPROPERTY(EditDefaultsOnly, Category = "Config")
-	FName CellDoorKeyTag;
-
-
 	/*******************************************************************/
 	/* State */
 	/*******************************************************************/
 
 	/** Current CellDoorKeys overlapping BoxComp, ie placed on trigger */
 	UPROPERTY()
-	TArray<ADInteractableActor*> CellDoorKeys;
+	TSet<ADInteractableActor*> CellDoorKeys;
+
+	/** Weight of CellDoorKeys not picked up */
+	UPROPERTY(VisibleAnywhere, Category = "State")
+	float WeightOnTrigger;
 
 
 	/*******************************************************************/
 	/* Gameplay */
 	/*******************************************************************/
 
-	/** Bound callbacks for BoxComp OnBegin and OnEnd overlap events. Adds and removes ADInteractableActors from CellDoorKeys Array */
+	/** Bound callbacks for BoxComp OnBegin and OnEnd overlap events. Adds and removes ADInteractableActors from CellDoorKeys */
 	UFUNCTION()
 	void OnBoxCompBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
 	UFUNCTION()
 	void OnBoxCompEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
 
+	/** Bound to OnPickedUpStateChanged of each key in CellDoorKeys. Picked up keys do not count towards weight */
+	void OnKeyPickedUpStateChanged(ADInteractableActor* Key, bool bIsPickedUp);
+
 };
@@ -11,6 +11,12 @@
 class UStaticMeshComponent;
 class UPhysicsConstraintComponent;
 class USphereComponent;
+class UDInteractableOutlineSubsystem;
+class ADInteractableActor;
+
+
+/** Declare delegate for picked up state change */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnPickedUpStateChanged, ADInteractableActor* /* InteractableActor */, bool /* bIsPickedUp */);
 
 
 /**
@@ -26,9 +32,6 @@ public:
 	// Sets default values for this actor's properties
 	ADInteractableActor();
 
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
-
 	/*******************************************************************/
 	/* Player Interaction */
 	/*******************************************************************/
@@ -45,24 +48,51 @@ public:
 	 */
 	bool GetIsPickedUp() const { return bIsPickedUp; }
 
-	/** Set MeshComp outline visibility. Outline is achieved via setting CustomDepthStencile values.  */
-	void SetEnableMeshCompOutline(bool Enable);
+	/** Broadcast from GrabActor() and ReleaseActor(). See ADCellDoorTrigger */
+	FOnPickedUpStateChanged OnPickedUpStateChanged;
+
+	/** Weight in kg, MeshComp mass is overridden with it */
+	float GetWeight() const { return Weight; }
+
+	/** Does this actor count towards weight on ADCellDoorTrigger */
+	bool IsCellDoorKey() const { return bIsCellDoorKey; }
 
 	/**
-     *  Check to see if InteractionAlertTrigger has line of sight to this Actor.
-     *  InteractionAlertTrigger will be set from OnInteractionAlertSphereCompBeginOverlap and OnInteractionAlertSphereCompEndOverlap
-     */
-	bool UnobstructedViewToInteractionAlertTrigger() const;
+	 * Set MeshComp outline visibility. Outline is achieved via setting CustomDepthStencile values. Render state is only touched when Enable
+	 * differs from the current state. Outlines are normally decided by UDInteractableOutlineSubsystem
+	 */
+	void SetEnableMeshCompOutline(bool Enable);
 
-	/** Get the InteractionAlertTrigger. Will be set when overlapping with InteractionAlertSphereComp */
+	bool IsOutlineEnabled() const { return bOutlineEnabled; }
+
+	/** Outline may be shown if InteractionAlertTrigger has line of sight. False while picked up. Player teleport is handled by UDInteractableOutlineSubsystem */
+	bool CanShowOutline() const { return !bIsPickedUp; }
+
+	/** Location line of sight to InteractionAlertTrigger is traced from */
+	FVector GetInteractionAlertLocation() const;
+
+	/** Get the InteractionAlertTrigger. Will be set when overlapping with InteractionAlertSphereComp, or by UDInteractableProximitySubsystem */
 	UPrimitiveComponent* GetInteractionAlertTrigger() const { return InteractionAlertTrigger; }
 
+	/** Trigger came within interaction alert range, replaces the current InteractionAlertTrigger */
+	void BeginInteractionAlert(UPrimitiveComponent* Trigger);
+
+	/** Trigger left interaction alert range */
+	void EndInteractionAlert(UPrimitiveComponent* Trigger);
+
+	/** Set bUseProximityService. Only has effect before BeginPlay, e.g. on deferred spawn */
+	void SetUseProximityService(bool bUse) { bUseProximityService = bUse; }
+
 
 protected:
 
+	virtual void PostInitializeComponents() override;
+
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 
 private:
 
@@ -86,6 +116,18 @@ private:
 	UPROPERTY(EditAnywhere, Category = "Config", meta = (ClampMin = "0.0", UIMin = "0.0"))
 	float Weight = 100.f;
 
+	/** Counts towards weight on ADCellDoorTrigger when placed on it. Actors tagged CellDoorKey are flagged in PostInitializeComponents */
+	UPROPERTY(EditAnywhere, Category = "Config")
+	bool bIsCellDoorKey = false;
+
+	/**
+	 * Find interaction alert triggers with UDInteractableProximitySubsystem instead of InteractionAlertSphereComp overlaps. InteractionAlertSphereComp
+	 * only sets the alert radius and its collision is turned off. MeshComp only generates overlap events while the player's head or hands are within
+	 * the alert radius, so hands can still grab it. Overlap volumes away from the player, e.g. ADCellDoorTrigger, do not see this actor
+	 */
+	UPROPERTY(EditAnywhere, Category = "Config|Proximity")
+	bool bUseProximityService = false;
+
 
 	/*******************************************************************/
 	/* State */
@@ -99,19 +141,10 @@ private:
 	UPROPERTY(VisibleAnywhere, Category = "State|MeshOoutline")
 	bool bOutlineEnabled;
 
-	/** MeshComp outline is turned off when player is teleporting. Keeps track of player teleport status  */
-	UPROPERTY(VisibleAnywhere, Category = "State|MeshOoutline")
-	bool bPlayerCharacterTeleporting;
-
 	/** Is this actor currently picked up  */
 	UPROPERTY(VisibleAnywhere, Category = "State|Interaction")
 	bool bIsPickedUp;
 
-private:
-
-	/** Setup. Player teleport state will determine if MeshComp outlines are shown. See OnPlayerBeginTeleport, and OnPlayerFinishTeleport */
-	void BindPlayerPawnTeleportEvents();
-
 
 	/*******************************************************************/
 	/* Mesh Outline */
@@ -119,21 +152,13 @@ private:
 
 private:
 
-	/** Trigger mesh outline */
+	/** Add and remove this actor as outline candidate of UDInteractableOutlineSubsystem */
 	UFUNCTION()
 	void OnInteractionAlertSphereCompBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
 	UFUNCTION()
 	void OnInteractionAlertSphereCompEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
 
-	/** Bound function to OnPlayerBeginTeleport delegate. See ADVRPlayerCharacter. Hide MeshComp outline */
-	UFUNCTION()
-	void OnPlayerBeingTeleport();
-
-	/** Bound function to OnPlayerFinishTeleport delegate. See ADVRPlayerCharacter. Resume MeshComp outline */
-	UFUNCTION()
-	void OnPlayerFinishTeleport();
-
-	/** Determine if MeshComp outline should be shown */
-	void ProcessShowMeshOutline();
+	/** Outline subsystem of this actor's world */
+	UDInteractableOutlineSubsystem* GetOutlineSubsystem() const;
 
 };
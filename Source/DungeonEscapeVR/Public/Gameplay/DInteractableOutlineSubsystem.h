@@ -0,0 +1,118 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "WorldCollision.h"
+#include "DInteractableOutlineSubsystem.generated.h"
+
+
+/** Forward Declarations */
+class ADInteractableActor;
+class UPrimitiveComponent;
+
+
+/**
+ * Owns all ADInteractableActor outline decisions. Interactables add themselves as candidates while an interaction alert trigger (the player)
+ * is inside their InteractionAlertSphereComp. Each frame the candidates that were traced longest ago, weighted towards the closest, get an
+ * async line of sight trace, at most MaxOutlineTracesPerFrame traces per frame. Outlines are only changed when the result flips the state,
+ * and all changes are applied together in Tick
+ */
+UCLASS(Config = Game)
+class DUNGEONESCAPEVR_API UDInteractableOutlineSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+
+public:
+
+	UDInteractableOutlineSubsystem();
+
+	/** Start tracing line of sight from Interactable to Trigger. Replaces Interactable's previous trigger */
+	void AddOutlineCandidate(ADInteractableActor* Interactable, UPrimitiveComponent* Trigger);
+
+	/** Stop tracing Interactable and hide its outline */
+	void RemoveOutlineCandidate(ADInteractableActor* Interactable);
+
+	/** Interactable can no longer show its outline, e.g. picked up. Outline is hidden now instead of after the next trace */
+	void HideOutline(ADInteractableActor* Interactable);
+
+	/**
+	 * Published once per change by ADVRPlayerCharacter. Outlines are hidden and no traces are issued while the player is teleporting.
+	 * Only outline candidates are touched, the cost does not grow with the number of interactables
+	 */
+	void SetPlayerTeleporting(bool bTeleporting);
+
+	bool IsPlayerTeleporting() const { return bPlayerTeleporting; }
+
+	/** FTickableGameObject */
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override { return OutlineCandidates.Num() > 0 || PendingOutlineChanges.Num() > 0; }
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+	virtual TStatId GetStatId() const override;
+
+
+private:
+
+	/*******************************************************************/
+	/* Config */
+	/*******************************************************************/
+
+	/** Line of sight traces issued per frame across all candidates */
+	UPROPERTY(Config)
+	int32 MaxOutlineTracesPerFrame;
+
+	/** Time in seconds before a candidate can be traced again */
+	UPROPERTY(Config)
+	float MinOutlineTraceInterval;
+
+
+	/*******************************************************************/
+	/* State */
+	/*******************************************************************/
+
+	struct FOutlineCandidate
+	{
+		/** Passed as trace user data to find the candidate when the trace completes */
+		uint32 Id;
+
+		TWeakObjectPtr<ADInteractableActor> Interactable;
+		TWeakObjectPtr<UPrimitiveComponent> Trigger;
+
+		/** World time of the last issued trace */
+		float LastTraceTime;
+		bool bTracePending;
+	};
+
+	TArray<FOutlineCandidate> OutlineCandidates;
+
+	/** Id given to the next candidate. 0 is never used */
+	uint32 NextCandidateId;
+
+	/** Outline changes from completed traces, applied in Tick */
+	TMap<TWeakObjectPtr<ADInteractableActor>, bool> PendingOutlineChanges;
+
+	/** Player is teleporting, see SetPlayerTeleporting() */
+	bool bPlayerTeleporting;
+
+	/** Bound to OnOutlineTraceCompleted() */
+	FTraceDelegate OutlineTraceDelegate;
+
+
+	/*******************************************************************/
+	/* Traces */
+	/*******************************************************************/
+
+	/** Issue traces for the highest priority candidates within MaxOutlineTracesPerFrame */
+	void IssueOutlineTraces();
+
+	/** Bound to OutlineTraceDelegate. Queue outline change if line of sight result flips interactable's outline */
+	void OnOutlineTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+	/** Apply PendingOutlineChanges */
+	void ApplyOutlineChanges();
+
+};
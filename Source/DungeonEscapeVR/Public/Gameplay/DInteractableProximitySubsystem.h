@@ -0,0 +1,121 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "DInteractableProximitySubsystem.generated.h"
+
+
+/** Forward Declarations */
+class ADInteractableActor;
+class UPrimitiveComponent;
+
+
+/**
+ * Answers which interactables are near the player's head and hands from a spatial hash, in place of per-actor InteractionAlertSphereComp
+ * overlaps. Interactables opt in with bUseProximityService, the player registers its head and hands as proximity sources. Each tick only
+ * interactables that moved, i.e. awake or carried, are rehashed, and each source queries the cells around it. An interactable is near a
+ * source inside its alert radius, the nearest source becomes its interaction alert trigger
+ */
+UCLASS(Config = Game)
+class DUNGEONESCAPEVR_API UDInteractableProximitySubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+
+public:
+
+	UDInteractableProximitySubsystem();
+
+	/** Track Interactable in the spatial hash. Near within AlertRadius cm */
+	void RegisterInteractable(ADInteractableActor* Interactable, float AlertRadius);
+	void UnregisterInteractable(ADInteractableActor* Interactable);
+
+	/** Player component interactables are alerted to, e.g. head or hand */
+	void RegisterProximitySource(UPrimitiveComponent* Source);
+
+	/** Registered interactables within their alert radius of Location */
+	void QueryNearbyInteractables(const FVector& Location, TArray<ADInteractableActor*>& OutInteractables) const;
+
+	int32 GetNumRegisteredInteractables() const { return Interactables.Num(); }
+
+	/** FTickableGameObject */
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override { return Interactables.Num() > 0; }
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+	virtual TStatId GetStatId() const override;
+
+
+private:
+
+	/*******************************************************************/
+	/* Config */
+	/*******************************************************************/
+
+	/** Size in cm of a spatial hash cell. Should be about the largest alert radius */
+	UPROPERTY(Config)
+	float ProximityCellSize;
+
+
+	/*******************************************************************/
+	/* State */
+	/*******************************************************************/
+
+	struct FProximityInteractable
+	{
+		TWeakObjectPtr<ADInteractableActor> Interactable;
+		float AlertRadius;
+
+		/** Cell Interactable is stored in */
+		FIntVector Cell;
+
+		/** Bound to TransformUpdated of Interactable's root component, see OnInteractableTransformUpdated() */
+		FDelegateHandle TransformUpdatedHandle;
+	};
+
+	TArray<FProximityInteractable> Interactables;
+
+	/** Index into Interactables of each registered interactable. Keys are never dereferenced */
+	TMap<const ADInteractableActor*, int32> InteractableIndices;
+
+	/** Interactables whose root component moved since the last tick, only these are rehashed */
+	TSet<const ADInteractableActor*> MovedInteractables;
+
+	/** Indices into Interactables of each occupied cell */
+	TMap<FIntVector, TArray<int32>> Cells;
+
+	/** Largest registered alert radius, cells within it of a query location are searched */
+	float MaxAlertRadius;
+
+	TArray<TWeakObjectPtr<UPrimitiveComponent>> ProximitySources;
+
+	/** Interaction alert trigger given to each interactable last tick */
+	TMap<TWeakObjectPtr<ADInteractableActor>, TWeakObjectPtr<UPrimitiveComponent>> AlertedInteractables;
+
+
+	/*******************************************************************/
+	/* Spatial Hash */
+	/*******************************************************************/
+
+	FIntVector GetCell(const FVector& Location) const;
+
+	void AddToCell(int32 Index);
+	void RemoveFromCell(int32 Index);
+
+	/** Remove interactable at Index from Interactables and its cell */
+	void RemoveInteractableAt(int32 Index);
+
+	/** Move interactables that moved since the last tick and changed cell */
+	void UpdateSpatialHash();
+
+	/** Bound to TransformUpdated of registered interactables' root components. Only awake or carried bodies update their transform */
+	void OnInteractableTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+	/** Alert interactables near proximity sources, and clear alerts of interactables no longer near */
+	void UpdateAlertedInteractables();
+
+};
@@ -0,0 +1,88 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "DCameraFadeComponent.generated.h"
+
+
+/** Forward Declarations */
+class FDCameraFadeViewExtension;
+
+
+/** Independent camera fades. The view is faded by the channel with the highest alpha */
+UENUM(BlueprintType)
+enum class ECameraFadeChannel : uint8
+{
+	ECFC_Teleport			UMETA(DisplayName = "Teleport"),
+	/** Camera collision sweeps */
+	ECFC_Collision			UMETA(DisplayName = "Collision"),
+	/** Distance to static collision from the map's baked static distance field */
+	ECFC_StaticCollision	UMETA(DisplayName = "StaticCollision"),
+
+	ECFC_MAX				UMETA(Hidden)
+};
+
+
+/** Fade of one ECameraFadeChannel. Alpha goes from StartAlpha at StartTime to TargetAlpha over Duration seconds of FPlatformTime::Seconds() */
+struct FCameraFadeState
+{
+	float StartAlpha = 0.f;
+	float TargetAlpha = 0.f;
+	double StartTime = 0.0;
+	double Duration = 0.0;
+	FLinearColor Color = FLinearColor::Black;
+
+	float GetAlpha(double Time) const
+	{
+		if (Duration <= 0.0 || Time >= StartTime + Duration) return TargetAlpha;
+
+		const float FadeProgress = static_cast<float>(FMath::Max(Time - StartTime, 0.0) / Duration);
+		return FMath::Lerp(StartAlpha, TargetAlpha, FadeProgress);
+	}
+};
+
+
+/**
+ * Fades the owning player's view. A fade is set once per change with a target alpha, rate and color, and is interpolated on the render thread
+ * from timestamps by a scene view extension, so fades stay smooth while the game thread hitches and nothing is ticked on the game thread.
+ * Fades use real time and keep running while the game is paused
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class DUNGEONESCAPEVR_API UDCameraFadeComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	UDCameraFadeComponent();
+
+	/** Fade Channel from FromAlpha to ToAlpha over Duration seconds. Duration of 0 sets ToAlpha immediately */
+	void StartFade(ECameraFadeChannel Channel, float FromAlpha, float ToAlpha, float Duration, const FLinearColor& Color);
+
+	/** Fade Channel from its current alpha to ToAlpha at Rate alpha per second. Rate of 0 sets ToAlpha immediately */
+	void FadeTo(ECameraFadeChannel Channel, float ToAlpha, float Rate, const FLinearColor& Color);
+
+	/** Current alpha of Channel, evaluated on the game thread */
+	float GetFadeAlpha(ECameraFadeChannel Channel) const;
+
+
+protected:
+
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
+
+
+private:
+
+	/** Game thread copy of fades sent to ViewExtension */
+	FCameraFadeState FadeStates[static_cast<int32>(ECameraFadeChannel::ECFC_MAX)];
+
+	/** Applies fades to the view overlay color on the render thread */
+	TSharedPtr<FDCameraFadeViewExtension, ESPMode::ThreadSafe> ViewExtension;
+
+	/** Send fade of Channel to ViewExtension */
+	void SendFadeState(ECameraFadeChannel Channel) const;
+
+};
@@ -0,0 +1,144 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "DTeleportBlackoutSubsystem.generated.h"
+
+
+/**
+ * Deferred work run while the view is black during a teleport. TimeBudget is the time in seconds left this frame.
+ * Return true when finished, false to be called again on the next blackout frame
+ */
+DECLARE_DELEGATE_RetVal_OneParam(bool, FBlackoutWorkDelegate, double /* TimeBudget */);
+
+
+/** Work done during one teleport blackout window, logged when the window closes */
+struct FTeleportBlackoutReport
+{
+	/** Work items finished and still queued when the window closed */
+	int32 WorkFinished = 0;
+	int32 WorkRemaining = 0;
+
+	/** Frames work was run on and total time spent running work in seconds */
+	int32 FramesRun = 0;
+	double WorkTime = 0.0;
+
+	/** Time in seconds the window was open */
+	float WindowDuration = 0.f;
+};
+
+
+/**
+ * Runs deferred work while the view is fully black during a teleport. ADVRPlayerCharacter opens the blackout window when a teleport begins
+ * and closes it when the teleport finishes. Any system can queue work with QueueBlackoutWork(), it is run under BlackoutFrameBudget each frame
+ * the window is open. Work not finished when the window closes continues in the next teleport's window
+ */
+UCLASS(Config = Game)
+class DUNGEONESCAPEVR_API UDTeleportBlackoutSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+
+public:
+
+	UDTeleportBlackoutSubsystem();
+
+	/** Queue work to run in the next blackout window. Work with the same Name as queued work is not queued twice */
+	void QueueBlackoutWork(FName Name, const FBlackoutWorkDelegate& Work);
+
+	/** Open blackout window. Work starts BlackoutDelay seconds later, once the camera has faded to black */
+	void OpenBlackoutWindow(float BlackoutDelay);
+
+	/** Close blackout window and log a report of the work done */
+	void CloseBlackoutWindow();
+
+	bool IsBlackoutWindowOpen() const { return bBlackoutWindowOpen; }
+
+	/** Work done in the last closed blackout window */
+	const FTeleportBlackoutReport& GetLastBlackoutReport() const { return LastBlackoutReport; }
+
+	/** FTickableGameObject */
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override { return bBlackoutWindowOpen; }
+	virtual bool IsTickableWhenPaused() const override { return true; }
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+	virtual TStatId GetStatId() const override;
+
+
+private:
+
+	/*******************************************************************/
+	/* Config */
+	/*******************************************************************/
+
+	/** Time in milliseconds per blackout frame to spend running queued work */
+	UPROPERTY(Config)
+	float BlackoutFrameBudget;
+
+	/** Collect garbage and purge it within the budget each blackout window */
+	UPROPERTY(Config)
+	bool bCollectGarbageInBlackout;
+
+	/** Advance pending level streaming within the budget each blackout window, e.g. the pause room */
+	UPROPERTY(Config)
+	bool bAdvanceLevelStreamingInBlackout;
+
+	/**
+	 * Time in seconds streaming levels are advanced for at most after the work starts. Levels still pending then finish streaming
+	 * through the engine's normal per frame streaming, so a large level does not hold up work queued after it
+	 */
+	UPROPERTY(Config)
+	float LevelStreamingBlackoutTimeout;
+
+
+	/*******************************************************************/
+	/* State */
+	/*******************************************************************/
+
+	struct FBlackoutWork
+	{
+		FName Name;
+		FBlackoutWorkDelegate Work;
+	};
+
+	/** Work waiting to run, run in order */
+	TArray<FBlackoutWork> QueuedWork;
+
+	bool bBlackoutWindowOpen;
+
+	/** World time the window was opened and the view is black */
+	float BlackoutWindowOpenTime;
+	float BlackoutStartTime;
+
+	/** Report of the open window, and the last closed window */
+	FTeleportBlackoutReport BlackoutReport;
+	FTeleportBlackoutReport LastBlackoutReport;
+
+	/** Frame garbage collection was requested on. See CollectGarbageWork() */
+	uint64 GarbageCollectionRequestFrame;
+
+	/** Real time level streaming work first ran, 0 until it runs. See AdvanceLevelStreamingWork() */
+	double LevelStreamingWorkStartTime;
+
+
+	/*******************************************************************/
+	/* Built-in Work */
+	/*******************************************************************/
+
+	/** Request garbage collection, then purge unreachable objects with the blackout budget */
+	bool CollectGarbageWork(double TimeBudget);
+
+	/**
+	 * Advance pending async loads within the budget and update streaming levels. Finished once no streaming level of this world is
+	 * loading, unloading or changing visibility, or after LevelStreamingBlackoutTimeout
+	 */
+	bool AdvanceLevelStreamingWork(double TimeBudget);
+
+	/** Is any streaming level of this world between streaming states */
+	bool IsLevelStreamingPending() const;
+
+};
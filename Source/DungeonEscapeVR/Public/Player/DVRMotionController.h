@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Kismet/GameplayStaticsTypes.h"
+#include "Player/DVRPoseHistory.h"
 #include "DVRMotionController.generated.h"
 
 
@@ -18,7 +20,9 @@ class UPhysicsConstraintComponent;
 class UHapticFeedbackEffect_Base;
 class USplineComponent;
 class USplineMeshComponent;
+class UInstancedStaticMeshComponent;
 class UWidgetInteractionComponent;
+class ANavigationData;
 
 /** States for MotionController. */
 UENUM(BlueprintType)
@@ -37,6 +41,70 @@ enum class EControllerMode : uint8
 	ECM_Game		UMETA(DisplayValue = "Game")
 };
 
+/** How teleport projectile path collision queries are run */
+UENUM(BlueprintType)
+enum class ETeleportTraceMode : uint8
+{
+	/** Trace full projectile path every frame, game thread waits on scene queries */
+	ETTM_Blocking	UMETA(DisplayName = "Blocking"),
+	/** Projectile path sweeps are issued with async trace API, results are used the following frame */
+	ETTM_Async		UMETA(DisplayName = "Async"),
+	/** Bounds of projectile path are tested against scene first, only path segments inside overlapping bounds are swept */
+	ETTM_Broadphase	UMETA(DisplayName = "Broadphase")
+};
+
+
+/** Haptic effect waiting to be played on a motion controller. See ADVRMotionController::QueueHapticEffect() */
+USTRUCT()
+struct FQueuedHapticEffect
+{
+	GENERATED_BODY()
+
+	/** Referenced so an effect only loaded by the caller is not collected while queued or playing */
+	UPROPERTY()
+	UHapticFeedbackEffect_Base* HapticEffect = nullptr;
+
+	/** Scale of effect amplitude, 0 - 1 */
+	UPROPERTY()
+	float Intensity = 1.f;
+
+	/** Higher priority effects replace queued and playing effects with lower priority */
+	UPROPERTY()
+	int32 Priority = 0;
+};
+
+
+/**
+ * Result of a trace from the motion controller that can be reused while the motion controller pose stays within
+ * pose gating tolerance and the world near the hit has not changed. See ADVRMotionController::bEnablePoseGating
+ */
+struct FPoseGatedTraceCache
+{
+	/** MotionControllerComp world transform the trace was run from */
+	FTransform Pose;
+
+	/** Component hit by the trace and its world transform when it was hit */
+	TWeakObjectPtr<UPrimitiveComponent> HitComponent;
+	FTransform HitComponentTransform;
+
+	/** World transform of the actor owning HitComponent when it was hit */
+	FTransform HitActorTransform;
+
+	/** Impact point and normal of the hit. Space above it is checked for blocking objects when the actor hit has moved */
+	FVector HitLocation = FVector::ZeroVector;
+	FVector HitNormal = FVector::UpVector;
+
+	/** Actors grabbed by this and the other hand when the trace was run, they are ignored by teleport traces */
+	TWeakObjectPtr<AActor> GrabbedActor;
+	TWeakObjectPtr<AActor> OtherHandGrabbedActor;
+
+	/** World time the trace was run */
+	float TraceTime = 0.f;
+
+	/** Only valid when the trace hit something */
+	bool bValid = false;
+};
+
 
 /**
  * Base class for VR motion controllers
@@ -74,7 +142,7 @@ public:
 	 */
 	bool GetCurrentTeleportDestinationMarketLocation(FVector& OutLocation);
 
-	/** Clear all points on TeleportSplinePath. Will not delete any SplineMeshComponents from TeleportMeshObjectPool */
+	/** Hide all TeleportArcMeshComp segments */
 	void ClearTeleportPath();
 
 	/** Set visibility of TeleportDestinationMarker */
@@ -155,13 +223,22 @@ public:
 	/* Interaction */
 	/*******************************************************************/
 
-	/** Play haptic, player feedback, on motion controller */
-	void PlayHapticEffect(UHapticFeedbackEffect_Base* HapticEffect, float Intensity = 1.f) const;
+	/**
+	 * Queue haptic, player feedback, on motion controller. Requests in the same frame are coalesced into the one with the highest Priority,
+	 * then Intensity. Queued effect is played from UpdateHapticFeedback()
+	 */
+	void QueueHapticEffect(UHapticFeedbackEffect_Base* HapticEffect, float Intensity = 1.f, int32 Priority = 0);
+
+	/**
+	 * Play queued haptic effect, at most once per frame. Effect is dropped if the same effect is still playing, and waits until HapticMinInterval
+	 * passed since the last effect started unless it has a higher priority than the playing effect
+	 */
+	void UpdateHapticFeedback();
 
 	/**	If CurrentGrabedActor is a ADInteractableActor alert state of GrabState  */
 	void AlertGrabbedActorOfGrabState(EGrabState State) const;
 
-	/** Check for overlapping physics actors. Update Haptic feedback and GrabState */
+	/** Check for overlapping physics actors. Update Haptic feedback and GrabState. Only needs to be called while GrabCandidates is not empty */
 	void UpdateInteractionWithOverlappingActors();
 
 	/** Get the nearest Actor Implement physics overlapping with InteractionSphereComp */
@@ -170,14 +247,48 @@ public:
 	/** If InteractionSphere is currently overlapping an Actor implementing physics try to attach to PhysicsConstraintComp */
 	bool TryAttachOverlappedActorToPhysicsHandle();
 
-	/** Set MeshComp to MotionControllerComp location. Movement is swept to location.  */
+	/**
+	 * Measure distance between grabbed actor and where it is held in the hand with this frame's controller pose. If bLateUpdateGrabbedActor
+	 * is set sweep grabbed actor there, stopping at blocking hits, and measure what is left after the sweep
+	 */
+	void UpdateGrabbedActorTransform();
+
+	/** Set velocity of released actor from hand velocity estimated from PoseHistory. See bApplyReleaseVelocity */
+	void ApplyReleaseVelocity(AActor* ReleasedActor) const;
+
+	/** Distance in cm between grabbed actor and where it is held in the hand, last frame */
+	float GetGrabbedActorLag() const { return GrabbedActorLag; }
+
+	/** Clear recorded hand poses. Call when the hand is moved without the player moving it, e.g. teleport or snap turn */
+	void ResetPoseHistory() { PoseHistory.Reset(); }
+
+	/** Apply RelativeHandPositionOffset to MeshComp. Offset is constant, called from SetHand() and not every frame */
 	void UpdateMotionControllerTransform();
 
+	/** Number of hand component (MeshComp and its children) transform updates last frame. Only counted in non shipping builds */
+	int32 GetLastFrameHandTransformUpdateCount() const { return LastFrameHandTransformUpdateCount; }
+
 	/** Update the spline showing UI interaction */
 	void UpdateUIInteractionSpline();
 
-	/** Get the ends of the UI interaction trace. */
-	void GetUIInteractionTraceEnds(FVector& Start, FVector& End) const;
+	/** Add the start and end points of UIInteractionSpline. Points are moved by UpdateUIInteractionSpline() */
+	void InitUIInteractionSpline();
+
+	/**
+	 * Stretch UIInteractionBeamMeshComp from WidgetInteractionComp to the widget hit by WidgetInteractionComp's own trace, or to the
+	 * first blocking hit when no widget is hit. See bUseWidgetInteractionHitForUIPointer
+	 */
+	void UpdateUIInteractionBeam();
+
+	/**
+	 * Get the ends of the UI interaction trace.
+	 * @param OutHit	optional, set to the trace hit. OutHit->bBlockingHit is false if the trace did not hit anything
+	 */
+	void GetUIInteractionTraceEnds(FVector& Start, FVector& End, FHitResult* OutHit = nullptr) const;
+
+	/** Get the fraction of pose gated updates that reused cached results. See bEnablePoseGating */
+	UFUNCTION(BlueprintPure)
+	float GetPoseGatingHitRate() const;
 
 
 protected:
@@ -218,9 +329,9 @@ private:
 	UPROPERTY(EditDefaultsOnly, Category = "Components")
 	UStaticMeshComponent* TeleportDestinationMarker;
 
-	/** Spline to show teleport projectile path */
+	/** Teleport projectile path mesh. One instance for each path segment, all segments are drawn and updated together */
 	UPROPERTY(VisibleAnywhere, Category = "Components")
-	USplineComponent* TeleportSplinePath;
+	UInstancedStaticMeshComponent* TeleportArcMeshComp;
 
 	/** Spline to show UI menu interaction */
 	UPROPERTY(VisibleAnywhere, Category = "Components")
@@ -229,6 +340,10 @@ private:
 	UPROPERTY(EditDefaultsOnly, Category = "Components")
 	USplineMeshComponent* UIInteractionSplineMesh;
 
+	/** Straight UI menu interaction beam, used instead of UIInteractionSpline when bUseWidgetInteractionHitForUIPointer is set. Mesh should point along X axis */
+	UPROPERTY(EditDefaultsOnly, Category = "Components")
+	UStaticMeshComponent* UIInteractionBeamMeshComp;
+
 
 
 
@@ -244,7 +359,7 @@ private:
 	UPROPERTY(EditDefaultsOnly, Category = "Config|HandMesh")
 	float HandScale;
 
-	/** Hand offset from UMotionControllerComponent. MeshComp is swept to prevent going through blocing collisions */
+	/** Hand offset from UMotionControllerComponent. Applied once when hand is set, see SetHand() */
 	UPROPERTY(EditDefaultsOnly, Category = "Config|HandMesh")
 	FVector RelativeHandPositionOffset;
 
@@ -263,14 +378,102 @@ private:
 	UPROPERTY(EditDefaultsOnly, Category = "Config|Teleport")
 	bool bTeleportTraceComplex;
 
+	/** Number of projectile path segments per second of TeleportSimulationTime. Each segment is one sphere sweep */
+	UPROPERTY(EditDefaultsOnly, Category = "Config|Teleport", meta = (ClampMin = "1.0", UIMin = "1.0"))
+	float TeleportSimulationFrequency;
+
+	/**
+	 * How projectile path collision is checked. In ETTM_Async mode the teleport destination marker and projectile path
+	 * are drawn from the previous frame's results so the game thread never waits on scene queries
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Config|Teleport")
+	ETeleportTraceMode TeleportTraceMode;
+
 	/** Mesh for teleport projectile path points */
 	UPROPERTY(EditDefaultsOnly, Category = "Config|Teleport|Spline")
 	UStaticMesh* TeleportArchMesh;
 
-	/** Materials for teleport projectile path points */
+	/**
+	 * Material for teleport projectile path points. Must have "Used with Instanced Static Meshes" set, TeleportArcMeshComp draws
+	 * with the default material in cooked builds otherwise
+	 */
 	UPROPERTY(EditDefaultsOnly, Category = "Config|Teleport|Spline")
 	UMaterialInterface* TeleportArchMaterial;
 
+	/**
+	 * Maximum number of teleport projectile path segments drawn. TeleportArcMeshComp instances are created once on BeginPlay.
+	 * Longer paths are drawn whole with each segment spanning several path points
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Config|Teleport|Spline", meta = (ClampMin = "1", UIMin = "1"))
+	int32 MaxTeleportArcSegments;
+
+	/**
+	 * Draw UI interaction with UIInteractionBeamMeshComp stretched to WidgetInteractionComp's last hit. No extra trace is run while
+	 * pointing at a widget and UIInteractionSpline is not rebuilt. The widget hit is from WidgetInteractionComp's previous tick, so
+	 * the beam end lags the controller by one frame. When not set UI interaction traces on its own and is drawn with UIInteractionSpline
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Config|UIInteraction")
+	bool bUseWidgetInteractionHitForUIPointer;
+
+	/**
+	 * Reuse the previous teleport projectile path, destination marker and UI interaction spline while the motion controller
+	 * has moved less than PoseGatingLocationTolerance and PoseGatingRotationTolerance and the world near the previous hit has not
+	 * changed: the component hit has not moved, grabbed actors are the same and navigation has not been rebuilt. When only the
+	 * rest of the actor hit has moved, PoseGatingHitClearance above the hit must be free. Other changes, such as a prop landing
+	 * on the target, are picked up by retracing at least every PoseGatingMaxReuseTime
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Config|PoseGating")
+	bool bEnablePoseGating;
+
+	/**
+	 * Distance in cm motion controller can move and still reuse previous trace results. Tracking jitter of a controller held
+	 * still is well under a millimetre and hand tremor a few millimetres, the default keeps a hesitating hand within tolerance
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Config|PoseGating", meta = (ClampMin = "0.0", UIMin = "0.0", EditCondition = "bEnablePoseGating"))
+	float PoseGatingLocationTolerance;
+
+	/**
+	 * Angle in degrees motion controller can rotate and still reuse previous trace results. Rotation moves the far end of the
+	 * trace the most, at the default 0.5 degrees the end of a 10 m teleport arc is off by less than 9 cm
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Config|PoseGating", meta = (ClampMin = "0.0", UIMin = "0.0", EditCondition = "bEnablePoseGating"))
+	float PoseGatingRotationTolerance;
+
+	/**
+	 * Radius in cm of the space above the previous hit that must be free of blocking objects, other than the component hit and
+	 * the player, to reuse trace results after other parts of the actor hit have moved, e.g. a cell door swinging over its frame
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Config|PoseGating", meta = (ClampMin = "0.0", UIMin = "0.0", EditCondition = "bEnablePoseGating"))
+	float PoseGatingHitClearance;
+
+	/**
+	 * Time in seconds trace results are reused for at most. Bounds how long changes that are not checked every update take to
+	 * show, such as a prop landing on the target or a cell door closing across the teleport arc. The default is about visual
+	 * reaction time, so a stale arc is rarely acted on before it updates, and costs one trace every 22 frames at 90 Hz
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Config|PoseGating", meta = (ClampMin = "0.0", UIMin = "0.0", EditCondition = "bEnablePoseGating"))
+	float PoseGatingMaxReuseTime;
+
+	/**
+	 * Sweep grabbed actor to this frame's controller pose before physics runs, instead of waiting for PhysicsConstraintComp
+	 * to pull it to the hand. Reduces grabbed actor lagging behind the hand. The sweep stops at blocking hits so held actors
+	 * can not be pushed through walls, PhysicsConstraintComp keeps pulling them towards the hand from there. Rotation is not swept
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Config|Interaction")
+	bool bLateUpdateGrabbedActor;
+
+	/** Set grabbed actor velocity from recent hand movement when released, instead of leaving it to the velocity PhysicsConstraintComp gave it */
+	UPROPERTY(EditDefaultsOnly, Category = "Config|Interaction")
+	bool bApplyReleaseVelocity;
+
+	/** Time in seconds of hand poses used to estimate release velocity */
+	UPROPERTY(EditDefaultsOnly, Category = "Config|Interaction", meta = (ClampMin = "0.02", UIMin = "0.02", ClampMax = "0.25", UIMax = "0.25", EditCondition = "bApplyReleaseVelocity"))
+	float ReleaseVelocityWindow;
+
+	/** Min time in seconds between starting haptic effects on this hand. Higher priority effects ignore this */
+	UPROPERTY(EditDefaultsOnly, Category = "Config|Feedback", meta = (ClampMin = "0.0", UIMin = "0.0"))
+	float HapticMinInterval;
+
 	/** Feedback when overlapping interactable actor */
 	UPROPERTY(EditDefaultsOnly, Category = "Config|Feedback")
 	UHapticFeedbackEffect_Base* CanPickupHapticEffect;
@@ -303,9 +506,59 @@ private:
 	UPROPERTY(VisibleAnywhere, Category = "State|Teleport")
 	FVector TeleportDestination;
 
-	/** Cache meshes placed along spline showing path to teleport location  */
-	UPROPERTY()
-	TArray<USplineMeshComponent*> TeleportMeshObjectPool;
+	/** Handles for async projectile path sweeps issued last frame, one handle for each segment of TeleportTracePathPoints */
+	TArray<FTraceHandle> TeleportTraceHandles;
+
+	/** Projectile path points the pending TeleportTraceHandles sweeps were issued for */
+	TArray<FVector> TeleportTracePathPoints;
+
+	/** Closest blocking hit for each pending TeleportTraceHandles sweep. Set from OnTeleportTraceSegmentCompleted() */
+	TArray<FHitResult> TeleportTraceSegmentHits;
+
+	/** Number of pending TeleportTraceHandles sweeps that have completed */
+	int32 TeleportTraceCompletedCount;
+
+	/** Bound to OnTeleportTraceSegmentCompleted(), passed to every async projectile path sweep */
+	FTraceDelegate TeleportTraceDelegate;
+
+	/**
+	 * Per frame teleport buffers. Kept as members so they keep their allocations between frames and
+	 * looking for a teleport destination does not allocate memory once running
+	 */
+	TArray<FVector> TeleportPathBuffer;
+	TArray<FVector> TeleportBroadphasePathPoints;
+	TArray<AActor*> TeleportIgnoreActors;
+	FPredictProjectilePathParams TeleportPredictPathParams;
+	FPredictProjectilePathResult TeleportPredictPathResult;
+
+	/** Number of scene queries run by teleport projectile path solvers. Used for benchmarking solvers */
+	int32 TeleportTraceQueryCount;
+
+	/** MotionControllerComp world transform the pending TeleportTraceHandles sweeps were issued from */
+	FTransform TeleportTracePose;
+
+	/** Last teleport projectile path hit, see bEnablePoseGating */
+	FPoseGatedTraceCache TeleportPathTraceCache;
+
+	/** Last UI interaction trace hit, see bEnablePoseGating */
+	FPoseGatedTraceCache UIInteractionTraceCache;
+
+	/** Current length of UIInteractionBeamMeshComp in cm */
+	float UIInteractionBeamLength;
+
+	/** Number of teleport and UI interaction updates that reused cached results */
+	UPROPERTY(VisibleAnywhere, Category = "State|PoseGating")
+	int32 PoseGatingHitCount;
+
+	/** Number of teleport and UI interaction updates that had to trace */
+	UPROPERTY(VisibleAnywhere, Category = "State|PoseGating")
+	int32 PoseGatingMissCount;
+
+	/** Instance transforms for TeleportArcMeshComp, one for each of MaxTeleportArcSegments. Reused every update */
+	TArray<FTransform> TeleportArcInstanceTransforms;
+
+	/** Is any TeleportArcMeshComp segment currently shown */
+	bool bTeleportArcVisible;
 
 	/** Mesh placed along spline showing UI interaction selection */
 	UPROPERTY()
@@ -323,6 +576,38 @@ private:
 	UPROPERTY(VisibleAnywhere, Category = "State|Interaction")
 	AActor* PreviousOverlappedPhysicsActor;
 
+	/** Grabbed actor root transform relative to InteractionSphereComp when grabbed */
+	FTransform GrabbedActorRelativeTransform;
+
+	/**
+	 * Distance in cm between grabbed actor and where it is held in the hand. With bLateUpdateGrabbedActor this is the distance
+	 * blocking geometry kept the actor from the hand after the sweep. See UpdateGrabbedActorTransform()
+	 */
+	UPROPERTY(VisibleAnywhere, Category = "State|Interaction")
+	float GrabbedActorLag;
+
+	/** Haptic effect waiting to play, see QueueHapticEffect() */
+	UPROPERTY()
+	FQueuedHapticEffect QueuedHapticEffect;
+
+	/** Haptic effect last played and when it started and stops playing */
+	UPROPERTY()
+	FQueuedHapticEffect PlayingHapticEffect;
+	float PlayingHapticEffectStartTime;
+	float PlayingHapticEffectEndTime;
+
+	/** InteractionSphereComp world poses of the last frames, used to estimate velocity of grabbed actor when released */
+	FDVRPoseHistory PoseHistory;
+
+	/** Hand component transform updates this frame and last frame, see OnHandComponentTransformUpdated() */
+	int32 HandTransformUpdateCount;
+	UPROPERTY(VisibleAnywhere, Category = "State|Debug")
+	int32 LastFrameHandTransformUpdateCount;
+
+	/** Interactables currently overlapping InteractionSphereComp. Updated from InteractionSphereComp begin and end overlap events, see IsGrabCandidate() */
+	UPROPERTY(VisibleAnywhere, Category = "State|Interaction")
+	TArray<AActor*> GrabCandidates;
+
 
 	/*******************************************************************/
 	/* Teleport */
@@ -330,7 +615,7 @@ private:
 
 	/**
 	 * Update the current teleport destination. Teleport destination is based on a predict projectile path. If updated destination is valid
-	 * destination will be shown using TeleportDestinationMarker and projectile path will be shown using TeleportSplinePath. This method is called
+	 * destination will be shown using TeleportDestinationMarker and projectile path will be shown using TeleportArcMeshComp. This method is called
 	 * every frame as long as bLookForTeleportDestination is true. 
 	 */
 	UFUNCTION()
@@ -347,28 +632,110 @@ private:
 	UFUNCTION()
 	bool FindTeleportDestination(TArray<FVector>& OutPath, FVector& OutLocation);
 
-	/** Set Actors to be ignored for teleport predict projectile path collision detection  */
+	/**
+	 * Same contract as FindTeleportDestination() without sweeping every path segment. Bounds of path segment ranges are
+	 * tested for blocking overlaps, ranges that overlap are split in half until a single segment is left to sweep.
+	 *
+	 * @param OutPath		points along projectile path up to the first blocking hit
+	 * @param OutLocation	Collision location of projectile path
+	 *
+	 * @return				Valid teleport destination found
+	 */
+	bool FindTeleportDestinationBroadphase(TArray<FVector>& OutPath, FVector& OutLocation);
+
+	/**
+	 * Find the first blocking hit along path segments between points FirstPoint and LastPoint of Points. See FindTeleportDestinationBroadphase()
+	 *
+	 * @param OutHit			First blocking hit along path segments
+	 * @param OutHitSegment		Index of the segment start point OutHit is on
+	 *
+	 * @return					true if a blocking hit was found
+	 */
+	bool SweepTeleportPathSegments(const TArray<FVector>& Points, int32 FirstPoint, int32 LastPoint, const FCollisionQueryParams& QueryParams, FHitResult& OutHit, int32& OutHitSegment);
+
+	/**
+	 * Collect results of async projectile path sweeps issued last frame by RequestAsyncTeleportDestination(). Path is cut off at
+	 * the first blocking hit and hit location projected to navmesh.
+	 *
+	 * @param OutPath		points along projectile path up to the first blocking hit
+	 * @param OutLocation	Collision location of projectile path, only set if return value is true
+	 * @param bOutHasResult	false if there were no sweep results from last frame to collect
+	 *
+	 * @return				Valid teleport destination found
+	 */
+	bool CollectAsyncTeleportDestination(TArray<FVector>& OutPath, FVector& OutLocation, bool& bOutHasResult);
+
+	/** Issue async sweeps along projectile path from current MotionControllerComp location. Results are collected next frame, see CollectAsyncTeleportDestination() */
+	void RequestAsyncTeleportDestination();
+
+	/** Bound to TeleportTraceDelegate. Store result of a projectile path sweep in TeleportTraceSegmentHits, UserData of TraceDatum is the path segment index */
+	void OnTeleportTraceSegmentCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+	/**
+	 * Get points along ballistic path of teleport projectile. Path is sampled TeleportSimulationFrequency times per second
+	 * for TeleportSimulationTime seconds using world gravity
+	 */
+	void GetTeleportProjectilePathPoints(const FVector& Start, const FVector& LaunchVelocity, TArray<FVector>& OutPoints) const;
+
+	/** Project teleport projectile path hit location to navmesh. Returns true if OutLocation was set */
+	bool ProjectTeleportLocationToNavigation(const FVector& HitLocation, FVector& OutLocation) const;
+
+	/** Set Actors to be ignored for teleport predict projectile path collision detection. OutIgnoreActors is reset first */
 	void SetIgnoreActorsForTeleportDestination(TArray<AActor*>& OutIgnoreActors);
 
+	/** Create MaxTeleportArcSegments hidden TeleportArcMeshComp instances */
+	void InitTeleportArcMesh();
+
+	/**
+	 * Stretch TeleportArcMeshComp instances between points along path generated from FindTeleportDesination. Segments past the end of Path are
+	 * hidden. When Path has more segments than instances, each instance spans several path points. All instances are updated with one call
+	 */
+	void UpdateTeleportArcMesh(const TArray<FVector>& Path);
+
+
+	/*******************************************************************/
+	/* Pose Gating */
+	/*******************************************************************/
+
 	/**
-	 * Set SplineMeshComponent locations along path generated from FindTeleportDesination. Points in Path param are added as SplineMeshComponents to TeleportSplinePath
-	 * Generated SplineMeshComponents will be added to TeleportMeshObjectPool
+	 * Check if cached trace results can be reused from Pose. Updates pose gating counters.
+	 * @returns true if bEnablePoseGating is set, Pose is within pose gating tolerance of Cache and the world near the hit has not changed
 	 */
-	void SetTeleportSplineMeshComponents(const TArray<FVector>& Path);
+	bool CanReuseTraceCache(const FPoseGatedTraceCache& Cache, const FTransform& Pose);
 
-	/** Update TeleportSplinePath for all points on Path, enable visibility */
-	void UpdateTeleportSpline(const TArray<FVector>& Path);
+	/** Store Hit traced from Pose in Cache. Cache is invalidated if Hit is nullptr or not a blocking hit */
+	void UpdateTraceCache(FPoseGatedTraceCache& Cache, const FTransform& Pose, const FHitResult* Hit) const;
+
+	/** Bound to OnNavigationGenerationFinishedDelegate of the navigation system. Teleport destination may no longer be on navmesh */
+	UFUNCTION()
+	void OnNavigationGenerationFinished(ANavigationData* NavData);
 
 
 	/*******************************************************************/
 	/* Interaction */
 	/*******************************************************************/
-	
+
 	/** Update GrabState state for overlapping physics actors
 	 * @param bIsOverlappingActorToGrab is there an actor currently overlapping InteractionSphereComp
 	 */
 	void UpdateGrabState(bool bIsOverlappingActorToGrab);
 
+	/** Bound to TransformUpdated of MeshComp and its children. Counts hand component transform updates */
+	void OnHandComponentTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+	/** Can Actor be grabbed when overlapping InteractionSphereComp. Only interactables with a primitive root component are kept in GrabCandidates */
+	bool IsGrabCandidate(const AActor* Actor) const;
+
+	/** Bound callbacks for InteractionSphereComp OnBegin and OnEnd overlap events. Adds and removes actors from GrabCandidates */
+	UFUNCTION()
+	void OnInteractionSphereCompBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+	UFUNCTION()
+	void OnInteractionSphereCompEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
+
+	/** Automation tests drive teleport searches directly */
+	friend class FDVRTeleportTraceBenchmarkTest;
+	friend class FDVRMotionControllerTickAllocationTest;
+
 public:
 
 	static const int32 UIINTERACTION_START_INDEX;
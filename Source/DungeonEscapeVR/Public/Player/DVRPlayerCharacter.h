@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
+#include "WorldCollision.h"
+#include "Player/DVRPoseHistory.h"
 #include "DVRPlayerCharacter.generated.h"
 
 
@@ -11,19 +13,23 @@
 class UCameraComponent;
 class ADVRMotionController;
 class USphereComponent;
+class UDCameraFadeComponent;
+class UDStaticDistanceFieldSubsystem;
 
 
 /** Decalre delegate for player teleporting change */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnPlayerBeginTeleport);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnPlayerFinishTeleport);
 
-/** Camera will fade out when moving into blocking collisions. States for camera fade out */
+/** Teleport progress. One teleport request goes FadingOut, FadingIn, Idle. See ADVRPlayerCharacter::BeginTeleport() */
 UENUM(BlueprintType)
-enum class ECameraCollisionState : uint8
+enum class ETeleportState : uint8
 {
-	ECCS_FadeOut	UMETA(DisplayName = "FadeOut"),
-	ECCS_FadeIn		UMETA(DisplayName = "FadeIn"),
-	ECCS_NotFading	UMETA(DisplayName = "NotFading")
+	ETS_Idle		UMETA(DisplayName = "Idle"),
+	/** Camera fading out, player is relocated when TimerHandle_Teleport fires */
+	ETS_FadingOut	UMETA(DisplayName = "FadingOut"),
+	/** Player relocated, camera fading back in. A new teleport request can interrupt this state */
+	ETS_FadingIn	UMETA(DisplayName = "FadingIn")
 };
 
 
@@ -53,9 +59,15 @@ public:
 	 */
 	void SetUIModeActive(bool Active);
 
-	/** Keep center of room scale in the same location. CameraComp and CapsuleComponent will move and player moves around play area */
+	/**
+	 * Keep center of room scale in the same location. CameraComp and CapsuleComponent will move and player moves around play area. Alignment is skipped
+	 * until CameraComp is more than RoomScaleAlignmentDeadZone away from CapsuleComponent
+	 */
 	void AlignRootToVRRoot();
 
+	/** Number of CapsuleComponent, VRCenter and CameraComp transform updates last frame. Only counted in non shipping builds */
+	int32 GetLastFrameCharacterTransformUpdateCount() const { return LastFrameCharacterTransformUpdateCount; }
+
 	/** Get the current rotation player is looking. Will get CameraComp's rotation */
 	FRotator GetPlayerViewRotation() const;
 
@@ -63,7 +75,13 @@ public:
 	 * Manually set the desired teleport location. Use with caution. Normal teleport destination should be set from calling StartFindTeleportDestination,
 	 * followed by FinishFindTeleportDestination. This will filter out invalid teleport destinations using MotionControllers
 	 */
-	void SetDesiredTeleportLocation(FVector Location) { DesiredTeleportLocation = Location; }
+	void SetDesiredTeleportLocation(FVector Location) { DesiredTeleportLocation = Location; bTeleportDestinationPending = false; }
+
+	/**
+	 * Teleport destination is not known yet, e.g. pause room is still streaming in. Teleport holds in the camera fade out until
+	 * SetDesiredTeleportLocation() is called
+	 */
+	void SetTeleportDestinationPending() { bTeleportDestinationPending = true; }
 
 	/**
 	 * Begin the process of teleporting. Teleporting consists of camera fade out, moving player to DesiredTeleportLocation, and
@@ -72,14 +90,24 @@ public:
 	 *	2. Player teleports from pause menu location
 	 *	3. Player teleports to DesiredTeleportLocation found by MotionControllers
 	 *
-	 * The teleport type is determined from bInPauseMenu and TeleportToPauseMenu param
+	 * The teleport type is determined from bInPauseMenu and TeleportToPauseMenu param. Each accepted request relocates the player once and
+	 * broadcasts OnPlayerBeginTeleport and OnPlayerFinishTeleport once. Returns false, and does nothing, while a teleport is fading out
 	 */
-	void BeginTeleport(bool TeleportToPauseMenu);
+	bool BeginTeleport(bool TeleportToPauseMenu);
+
+	/** True while camera is fading out for teleport and player has not been relocated yet */
+	bool IsTeleportInProgress() const { return TeleportState == ETeleportState::ETS_FadingOut; }
 
 
-	/** Helper function for fade camera in and out while teleporting */
+	/** Helper function for fade camera in and out while teleporting. See UDCameraFadeComponent */
 	void StartTeleportCameraFade(float FromAlpha, float ToAlpha, float Time);
 
+	/**
+	 * VRCenter world location that puts HMDLocation, relative to VRCenter rotated to NewRotation, at HMDTargetLocation on the horizontal plane.
+	 * VRCenter height is NewHeight. See RelocateVRCenter()
+	 */
+	static FVector GetRelocatedVRCenterLocation(const FVector& HMDTargetLocation, const FVector& HMDLocation, const FRotator& NewRotation, float NewHeight);
+
 
 protected:
 
@@ -105,6 +133,10 @@ private:
 	UPROPERTY(EditDefaultsOnly, Category = "Components")
 	USphereComponent* CameraCollisionComp;
 
+	/** Fades player's view for teleport and camera collision, interpolated on the render thread */
+	UPROPERTY(VisibleAnywhere, Category = "Components")
+	UDCameraFadeComponent* CameraFadeComp;
+
 
 	/*******************************************************************/
 	/* Config */
@@ -114,10 +146,60 @@ private:
 	UPROPERTY(EditDefaultsOnly, Category = "Config")
 	float DegreesOnTurn;
 
-	/** Rate to check for CameraCollisionComp overlapping with blocking collisions */
-	UPROPERTY(EditDefaultsOnly, Category = "Config|PlayerView")
+	/** Distance in cm CameraComp (HMD) can move from CapsuleComponent on the horizontal plane before CapsuleComponent is moved under it. See AlignRootToVRRoot() */
+	UPROPERTY(EditDefaultsOnly, Category = "Config|RoomScale", meta = (ClampMin = "0.0", UIMin = "0.0"))
+	float RoomScaleAlignmentDeadZone;
+
+	/**
+	 * Place snap turns and teleports from the HMD location predicted for the render thread's late update of this frame, instead of the
+	 * location sampled on the game thread. The rendered frame uses the late updated HMD pose, so the HMD has moved by the time the
+	 * relocation is rendered. Only that gap is predicted, both poses are already predicted to the same display time by the HMD runtime.
+	 * See GetLateUpdateGap()
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Config|RoomScale")
+	bool bPredictHMDLocationOnRelocation;
+
+	/** Time in seconds of HMD pose history used to estimate HMD velocity for prediction */
+	UPROPERTY(EditDefaultsOnly, Category = "Config|RoomScale", meta = (ClampMin = "0.0", UIMin = "0.0", EditCondition = "bPredictHMDLocationOnRelocation"))
+	float HMDPredictionVelocityWindow;
+
+	/**
+	 * Time in seconds between checks for CameraCollisionComp overlapping with blocking collisions while CameraComp (HMD) moves slower than
+	 * CameraCollisionSlowSpeed. Checks get more frequent as HMD moves faster, see CameraCollisionFastSpeed
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Config|PlayerView", meta = (ClampMin = "0.0", UIMin = "0.0"))
 	float CameraCollisionCheckRate;
 
+	/** HMD speed in cm/s at and below which camera collision is checked every CameraCollisionCheckRate seconds */
+	UPROPERTY(EditDefaultsOnly, Category = "Config|PlayerView", meta = (ClampMin = "0.0", UIMin = "0.0"))
+	float CameraCollisionSlowSpeed;
+
+	/** HMD speed in cm/s at and above which camera collision is checked every frame */
+	UPROPERTY(EditDefaultsOnly, Category = "Config|PlayerView", meta = (ClampMin = "0.0", UIMin = "0.0"))
+	float CameraCollisionFastSpeed;
+
+	/**
+	 * Time in seconds of HMD pose history the HMD speed for camera collision checks is estimated over. A few frames, so a head
+	 * starting to move fast is checked every frame from the next frame on
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Config|PlayerView", meta = (ClampMin = "0.0", UIMin = "0.0"))
+	float CameraCollisionSpeedWindow;
+
+	/**
+	 * Fade camera based on distance from HMD to the nearest static level collision when the map has a baked static distance field.
+	 * See UDStaticDistanceFieldSubsystem. Camera collision sweeps still fade the camera for collision that can move
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Config|PlayerView")
+	bool bFadeCameraFromStaticDistanceField;
+
+	/** Distance in cm from static collision camera starts to fade */
+	UPROPERTY(EditDefaultsOnly, Category = "Config|PlayerView", meta = (ClampMin = "0.0", UIMin = "0.0", EditCondition = "bFadeCameraFromStaticDistanceField"))
+	float StaticCollisionFadeStartDistance;
+
+	/** Distance in cm from static collision camera is fully faded */
+	UPROPERTY(EditDefaultsOnly, Category = "Config|PlayerView", meta = (ClampMin = "0.0", UIMin = "0.0", EditCondition = "bFadeCameraFromStaticDistanceField"))
+	float StaticCollisionFadeFullDistance;
+
 	/** Fade out color when camera (players HMD) is overlapping with blocking collision. Prevents player from seeing out of play area */
 	UPROPERTY(EditDefaultsOnly, Category = "Config|PlayerView")
 	FLinearColor CameraCollisionFadeColor;
@@ -146,6 +228,13 @@ private:
 	UPROPERTY(EditDefaultsOnly, Category = "Config|Teleport")
 	float TeleportToPauseTime;
 
+	/**
+	 * Time in seconds a teleport holds in the fade for a pending destination, see SetTeleportDestinationPending(). After this the
+	 * teleport to the pause menu is abandoned and the player fades back in where they are
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Config|Teleport", meta = (ClampMin = "0.0", UIMin = "0.0"))
+	float MaxTeleportDestinationWaitTime;
+
 	
 	/*******************************************************************/
 	/* Motion Controllers */
@@ -170,9 +259,19 @@ private:
 	UPROPERTY(VisibleAnywhere, Category = "State|Teleport")
 	bool bWantsToTeleport;
 
-	/** True when player is in process of teleporting. This includes camera fade in and out and character teleporting to new destination */
+	/** Current teleport state. See BeginTeleport() */
+	UPROPERTY(VisibleAnywhere, Category = "State|Teleport")
+	ETeleportState TeleportState;
+
+	/** Advances TeleportState, FadingOut to FadingIn, and FadingIn to Idle */
+	FTimerHandle TimerHandle_Teleport;
+
+	/** Waiting for SetDesiredTeleportLocation(). See SetTeleportDestinationPending() */
 	UPROPERTY(VisibleAnywhere, Category = "State|Teleport")
-	bool bTeleportInProgress;
+	bool bTeleportDestinationPending;
+
+	/** Time in seconds current teleport has held in the fade for a pending destination. See MaxTeleportDestinationWaitTime */
+	float TeleportDestinationWaitTime;
 
 	/**
 	 * When player pauses game they are teleported to separate location in the world. This is to avoid player pausing game and pause menu widget
@@ -185,8 +284,23 @@ private:
 	UPROPERTY(VisibleAnywhere, Category = "State|Controllers")
 	bool bUIModeActive;
 
-	/** CameraCollisionComp collision detection is run at slower independent rate from frame rate */
-	FTimerHandle TimerHandle_CheckCameraCollision;
+	/** Time in seconds since last camera collision check was issued. See UpdateCameraCollisionCheck() */
+	float TimeSinceCameraCollisionCheck;
+
+	/** Async camera collision sweep issued and its result not received yet. See OnCameraCollisionTraceCompleted() */
+	bool bCameraCollisionTracePending;
+
+	/** VRCenter was relocated while camera collision sweep was in flight, its result is for the old location */
+	bool bCameraCollisionTraceStale;
+
+	/** Bound to OnCameraCollisionTraceCompleted(), passed to async camera collision sweep */
+	FTraceDelegate CameraCollisionTraceDelegate;
+
+	/** Query params for camera collision sweep, ignoring this character, motion controllers and grabbed actors. See UpdateCameraCollisionQueryParams() */
+	FCollisionQueryParams CameraCollisionQueryParams;
+
+	/** Actors grabbed by left and right motion controller when CameraCollisionQueryParams was last updated */
+	TWeakObjectPtr<AActor> CameraCollisionIgnoredGrabbedActors[2];
 
 	/** Last position of CameraCollisionComp. Used to set bCameraCollisionOverlapping   */
 	FVector LastCameraCollisionCompLocation;
@@ -195,20 +309,39 @@ private:
 	UPROPERTY(VisibleAnywhere, Category = "State|PlayerView")
 	bool bCameraCollisionOverlapping;
 
-	/** Current CameraCollisonState. Will change when CameraCollisionComp overlaps with a collision that would block pawn trace */
-	ECameraCollisionState CameraCollisionState;
+	/** Camera fade amount from distance to static collision, 0 - 1. See UpdateStaticCollisionCameraFade() */
+	float StaticCollisionCameraFadeAmount;
+
+	/** HMD poses in tracking space (relative to VRCenter), added each tick. Unaffected by relocation */
+	FDVRPoseHistory HMDPoseHistory;
+
+	/** World location, horizontal only, the HMD was placed at by the last relocation. Compared to the rendered HMD location next frame */
+	FVector RelocationIntendedHMDLocation;
+	bool bMeasureRelocationError;
+
+	/** HMDPoseHistory time of the late update that rendered the last relocation. See GetLateUpdateGap() */
+	double RelocationLateUpdateTime;
 
-	/** Current amount of camera fade will be clamped between 0 and 1 */
-	float CollisionCameraFadeAmount;
+	/**
+	 * Horizontal distance in cm between intended and rendered HMD location of the last relocation. The rendered location is interpolated
+	 * from the tracked poses either side of the late update, not extrapolated like the prediction
+	 */
+	UPROPERTY(VisibleAnywhere, Category = "State|Debug")
+	float LastRelocationError;
+
+	/** CapsuleComponent, VRCenter and CameraComp transform updates this frame and last frame, see OnCharacterComponentTransformUpdated() */
+	int32 CharacterTransformUpdateCount;
+	UPROPERTY(VisibleAnywhere, Category = "State|Debug")
+	int32 LastFrameCharacterTransformUpdateCount;
 
 
 	/*******************************************************************/
 	/* Cached References */
 	/*******************************************************************/
 
-	/** Reference to PlayerCameraManager */
+	/** Reference to world's static distance field, only set if bFadeCameraFromStaticDistanceField and the map has one */
 	UPROPERTY()
-	APlayerCameraManager* PlayerCameraManager;
+	UDStaticDistanceFieldSubsystem* StaticDistanceFieldSubsystem;
 
 	/** Current location to teleport to can either be set from teleport location from LeftMotionController or from being set directly from SetDesiredTeleportLocation() */
 	UPROPERTY(BlueprintReadOnly, Category = "State|Teleport", meta = (AllowPrivateAccess = true))
@@ -240,32 +373,82 @@ private:
 
 private:
 
-	/** Setup camera fade and teleport timer to teleport to pause menu location. Will set RightMotionController controller mode to ECM_UI */
+	/** Setup camera fade to teleport to pause menu location. Will set RightMotionController controller mode to ECM_UI */
 	void SetupTeleportToPauseMenuLocation();
-	/** Setup camera fade and teleport timer to teleport from pause menu location. Will set RightMotionController controller mode to ECM_Game */
+	/** Setup camera fade to teleport from pause menu location. Will set RightMotionController controller mode to ECM_Game */
 	void SetupTeleportFromPauseMenuLocation();
 	/** Setup camera fade to teleport */
 	void SetupTeleport();
-	/** Move player to DesiredTeleportLocation, and fade camera back in. Alert ADVRPlayerController if this teleport was to the pause menu location */
+	/**
+	 * Move player to DesiredTeleportLocation, and fade camera back in. Alert ADVRPlayerController if this teleport was to the pause menu location.
+	 * Only runs in ETS_FadingOut, called once per teleport from TimerHandle_Teleport
+	 */
 	void FinishTeleport();
+	/** Camera has faded back in, TeleportState back to ETS_Idle */
+	void OnTeleportFadeInFinished();
+
+	/**
+	 * Move and rotate VRCenter to NewRotation so HMDLocation, relative to VRCenter, lands at HMDTargetLocation on the horizontal plane.
+	 * VRCenter height is set to NewHeight. HMDLocation should come from SampleRelocationHMDLocation()
+	 */
+	void RelocateVRCenter(const FVector& HMDTargetLocation, const FVector& HMDLocation, const FRotator& NewRotation, float NewHeight, ETeleportType Teleport);
+
+	/** Sample HMD location relative to VRCenter, predicted for the late update of this frame when bPredictHMDLocationOnRelocation */
+	FVector SampleRelocationHMDLocation();
+
+	/** Add HMD pose to HMDPoseHistory and measure error of the last relocation, see LastRelocationError */
+	void UpdateHMDPoseHistory();
+
+	/** HMD pose relative to VRCenter, from the HMD or HMDLocationOverride */
+	void GetTrackedHMDPose(FRotator& OutRotation, FVector& OutLocation) const;
+
+	/**
+	 * Estimated time in seconds from now until the render thread late updates the HMD pose for this frame. The game thread hands the
+	 * frame to the render thread once it finishes, so this is the rest of the game thread time, estimated from last frame
+	 */
+	float GetLateUpdateGap() const;
+
+	/** Tracked HMD location and late update gap used instead of the HMD and frame timing when set, lets automation tests drive relocations */
+	TOptional<FVector> HMDLocationOverride;
+	TOptional<float> LateUpdateGapOverride;
+
+	/** Automation tests drive relocations directly */
+	friend class FDVRRelocationPredictionTest;
 
 
 	/*******************************************************************/
 	/* Movement */
 	/*******************************************************************/
 	
+	/**
+	 * Issue CheckForCameraCollision() at a rate based on CameraComp (HMD) speed. Every frame at CameraCollisionFastSpeed and above,
+	 * every CameraCollisionCheckRate seconds at CameraCollisionSlowSpeed and below
+	 */
+	void UpdateCameraCollisionCheck(float DeltaTime);
+
 	/**
 	 * As player moves around in room scale setup check for collisions in game. If in game collisions are detected, ie walls, then
-	 * fade out camera. Prevents motion sickness. This method call rate can be adjusted via CameraCollisionCheckRate. There is no
-	 * need to call this method every frame
+	 * fade out camera. Prevents motion sickness. Collision is swept async, result is handled next frame in OnCameraCollisionTraceCompleted()
 	 */
 	void CheckForCameraCollision();
 
-	/** 
-	 * Fade players visibility. Prevents player from looking through blocking collisions while not inducing motion sickness. Camera will Adjust camera fade amount
-	 * as set CameraCollisionFadeState when fade amount reaches full fade in or fade out amount
-	*/
-	void CameraCollisionFade(float DeltaTime);
+	/**
+	 * Bound to CameraCollisionTraceDelegate. Fade camera out or in at CameraCollisionFadeRate when CameraCollisionComp starts or stops overlapping
+	 * blocking collisions. Prevents player from looking through blocking collisions while not inducing motion sickness
+	 */
+	void OnCameraCollisionTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+	/** Start the next camera collision sweep from where CameraComp is now. Called after VRCenter is relocated */
+	void ResetCameraCollisionSweep();
+
+	/** Update ignored actors in CameraCollisionQueryParams if motion controllers grabbed actors changed */
+	void UpdateCameraCollisionQueryParams();
+
+	/** Fade camera from HMD distance to static collision, looked up in the map's baked static distance field */
+	void UpdateStaticCollisionCameraFade();
+
+	/** Bound to TransformUpdated of CapsuleComponent, VRCenter and CameraComp. Counts character component transform updates */
+	void OnCharacterComponentTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
 
 
 	/*******************************************************************/
@@ -294,6 +477,12 @@ private:
 	void TurnLeft();
 	void TurnRight();
 
+	/** Snap turn VRCenter by Degrees around the HMD */
+	void SnapTurn(float Degrees);
+
+	/** Motion controllers are moved by teleport and snap turn, not the player. Keep that movement out of release velocity */
+	void ResetMotionControllerPoseHistory() const;
+
 	/** Start looking for valid teleport destination */
 	void StartFindTeleportDestination();
 	/** If valid teleport destination is found begin teleport to destination. Will set DesiredTeleportLocation */
@@ -21,7 +21,7 @@ public:
 
 	/**
 	 * Start Pausing the game. VRPlayerCharacter will be moved to PlayerPauseMenuLocation. Pause will not be complete until
-	 * PlayerCharacterInPauseMenu() is called
+	 * PlayerCharacterInPauseMenu() is called. If PauseRoomLevelName is set the pause room is streamed in first, while the camera fades out
 	 */
 	void PauseGame();
 
@@ -59,7 +59,10 @@ public:
 	/** VRPlayerCharacter has successfully escaped but decided to go back into the dungeon. Set VRPlayerCharacter back to ECM_Game Mode*/
 	void OnLeaveEscapeSuccessArea();
 
-	/** Pause or unpause the game. If Value is true game will be paused, and unpaused if false */
+	/**
+	 * Pause or unpause the game. If Value is true game will be paused, and unpaused if false. Called once the player has been relocated,
+	 * so the pause room is unloaded here when unpausing
+	 */
 	void PlayerCharacterInPauseMenu(bool Value);
 	
 
@@ -70,6 +73,16 @@ public:
 	/** Find first actor in world with Tag. This is slow, calls UGameplayStatics::GetAllActorsWithTag */
 	AActor* FindFirstActorWithTag(const FName& Tag) const;
 
+	/** Rotate PauseMenuLayoutActor so pause menu faces player */
+	void SetupPauseMenuLayout();
+
+	/** Latent callback of LoadStreamLevel for PauseRoomLevelName. Find pause location and send VRPlayerCharacter there */
+	UFUNCTION()
+	void OnPauseRoomLoaded();
+
+	/** Unload PauseRoomLevelName if it was loaded by PauseGame() */
+	void UnloadPauseRoom();
+
 
 protected:
 
@@ -92,6 +105,13 @@ private:
 	/** Actor tag that marks the layout actor for Pause menu. */
 	FName PauseMenuLayoutActorTag = FName(TEXT("PauseMenuWidgetLayout"));
 
+	/**
+	 * Streaming level containing the pause room, PauseLocation and PauseMenuWidgetLayout actors. Loaded when pausing and unloaded when
+	 * returning to game so the pause room does not use memory or tick during play. If None pause room actors are expected in the persistent level
+	 */
+	UPROPERTY(EditAnywhere, Category = "Configuration")
+	FName PauseRoomLevelName;
+
 	/*******************************************************************/
 	/* Pause */
 	/*******************************************************************/
@@ -115,6 +135,12 @@ private:
 	UPROPERTY(VisibleAnywhere, Category = "Pause")
 	FVector PlayerLocationWhenPaused;
 
+	/** Player view yaw when game is paused, pause menu is rotated to face it */
+	float PlayerViewYawWhenPaused = 0.f;
+
+	/** PauseRoomLevelName load was requested and the level has not been unloaded since. See UnloadPauseRoom() */
+	bool bPauseRoomRequested = false;
+
 
 	/*******************************************************************/
 	/* Cached References */
@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+/**
+ * Fixed size ring buffer of timestamped world poses. Adding a pose is O(1) and never allocates. Velocity is estimated
+ * with a least squares fit over the poses inside a time window, so the estimate does not depend on frame rate.
+ * Used by ADVRMotionController to give grabbed actors the hand velocity when released, and by ADVRPlayerCharacter to predict the HMD location
+ */
+struct FDVRPoseHistory
+{
+	/** Max number of poses kept, enough for 0.25 seconds at 120 Hz */
+	static constexpr int32 CAPACITY = 32;
+
+	/** Add pose sampled at Time in seconds. Time must be increasing, oldest pose is overwritten when full */
+	void AddPose(double Time, const FVector& Location, const FQuat& Rotation);
+
+	/** Remove all poses, e.g. after a teleport where the pose jumps */
+	void Reset();
+
+	/**
+	 * Least squares estimate of linear velocity in cm/s and angular velocity in rad/s (world space axis * rate) over the
+	 * poses added within Window seconds of the newest pose. Returns false if there are less than 2 poses in the window
+	 */
+	bool EstimateVelocity(float Window, FVector& OutLinearVelocity, FVector& OutAngularVelocity) const;
+
+	/**
+	 * Extrapolate location PredictionTime seconds past the newest pose, with the linear velocity estimated over Window seconds.
+	 * Returns the newest location if velocity can not be estimated, false if there are no poses
+	 */
+	bool PredictLocation(float Window, float PredictionTime, FVector& OutLocation) const;
+
+	/** Location at Time in seconds, interpolated between the poses either side of it. Returns false if Time is outside the kept poses */
+	bool GetLocationAtTime(double Time, FVector& OutLocation) const;
+
+	int32 Num() const { return NumPoses; }
+
+private:
+
+	struct FTimedPose
+	{
+		double Time;
+		FVector Location;
+		FQuat Rotation;
+	};
+
+	FTimedPose Poses[CAPACITY];
+
+	/** Index the next pose is written to */
+	int32 Head = 0;
+	int32 NumPoses = 0;
+};